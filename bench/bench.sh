@@ -0,0 +1,9 @@
+#!/bin/bash
+
+set -e
+
+for src in ${@:-bench_*.cc}; do
+    g++ $src -o ${src%.cc} -std=c++11 -O2 -lpthread
+    ./${src%.cc}
+    rm -rf ./${src%.cc}
+done
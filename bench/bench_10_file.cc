@@ -0,0 +1,63 @@
+/*
+*  @Filename : bench_10_file.cc
+*  @Description : parseFile against ifstream then parse, 1 GB unless the size in GB is given
+*  @Datatime : 2026/10/18 22:15:43
+*  @Author : xushun
+*/
+#include "../json.hh"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+using json = xushun::json;
+
+static double nowSec() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count() / 1e9;
+}
+
+// mostly long strings, so that the tree stays small next to the input
+size_t writeDoc(const char* path, double gb) {
+    std::string block = "{\"id\":1234567,\"ok\":true,\"v\":[0.5,-1e10],\"blob\":\"";
+    while (block.size() < 64 * 1024 - 4) { block += "abcdefghijklmnopqrstuvwxyz012345"; }
+    block += "\"},";
+    size_t blocks = (size_t)(gb * (1 << 30)) / block.size();
+    FILE* fp = fopen(path, "wb");
+    fputc('[', fp);
+    for (size_t i = 0; i < blocks; ++ i) { fwrite(block.data(), 1, block.size(), fp); }
+    fputs("null]", fp);
+    fclose(fp);
+    return blocks * block.size() + 6;
+}
+
+int main(int argc, char** argv) {
+
+    double gb = argc > 1 ? atof(argv[1]) : 1;
+    const char* path = "/tmp/xushun_json_bench_file.json";
+    size_t size = writeDoc(path, gb);
+    printf("%.2f GB\n", size / double(1 << 30));
+
+    double start = nowSec();
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        std::string doc = buffer.str();
+        json j;
+        j.parse(doc);
+    }
+    double sec = nowSec() - start;
+    printf("ifstream + parse   %8.1f MB/s\n", size / sec / 1e6);
+
+    start = nowSec();
+    {
+        json j;
+        j.parseFile(path);
+    }
+    sec = nowSec() - start;
+    printf("parseFile          %8.1f MB/s\n", size / sec / 1e6);
+
+    remove(path);
+    return 0;
+}
@@ -0,0 +1,77 @@
+/*
+*  @Filename : bench_11_arena.cc
+*  @Description : parse, traversal and teardown, heap against arena documents
+*  @Datatime : 2026/10/19 10:48:26
+*  @Author : xushun
+*/
+#include "../json.hh"
+#include <chrono>
+#include <cstdio>
+
+using json = xushun::json;
+
+static double nowSec() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count() / 1e9;
+}
+
+std::string recordsDoc(int count) {
+    std::string doc = "[";
+    for (int i = 0; i < count; ++ i) {
+        if (i > 0) { doc += ","; }
+        doc += "{\"id\":" + std::to_string(i) + ",\"name\":\"customer number " + std::to_string(i)
+             + "\",\"email\":\"customer" + std::to_string(i) + "@example.com\",\"tags\":[\"a\",\"bb\",\"a longer tag value\"],"
+             + "\"address\":{\"city\":\"Hangzhou\",\"street\":\"West Lake Road " + std::to_string(i % 500) + "\",\"zip\":310000}}";
+    }
+    return doc + "]";
+}
+
+double traverse(json& j) {
+    switch (j.getType()) {
+        case json::JSON_NUMBER: return j.getNumber();
+        case json::JSON_STRING: return (double)j.getString().size();
+        case json::JSON_ARRAY: {
+            double sum = 0;
+            for (size_t i = 0; i < j.getArraySize(); ++ i) { sum += traverse(j[i]); }
+            return sum;
+        }
+        case json::JSON_OBJECT: {
+            double sum = 0;
+            for (const char* key : {"id", "name", "email", "tags", "address", "city", "street", "zip"}) {
+                if (j.existObjectElement(key)) { sum += traverse(j[key]); }
+            }
+            return sum;
+        }
+        default: return 0;
+    }
+}
+
+void bench(const char* name, const std::string& doc, bool useArena) {
+    double best[3] = {1e9, 1e9, 1e9}, sum = 0;
+    for (int round = 0; round < 3; ++ round) {
+        json* j = new json();
+        if (useArena) { j->setArena(); }
+        double start = nowSec();
+        j->parse(doc);
+        double parsed = nowSec();
+        sum = traverse(*j);
+        double traversed = nowSec();
+        delete j;
+        double freed = nowSec();
+        best[0] = std::min(best[0], parsed - start);
+        best[1] = std::min(best[1], traversed - parsed);
+        best[2] = std::min(best[2], freed - traversed);
+    }
+    printf("%-8s parse %8.1f ms   traverse %8.1f ms   teardown %8.2f ms   (%.0f)\n",
+        name, best[0] * 1e3, best[1] * 1e3, best[2] * 1e3, sum);
+}
+
+int main(int argc, char** argv) {
+
+    std::string doc = recordsDoc(300000);
+    printf("%.2f MB\n", doc.size() / 1e6);
+    bench("heap", doc, false);
+    bench("arena", doc, true);
+
+    return 0;
+}
@@ -0,0 +1,93 @@
+/*
+*  @Filename : bench_12_object.cc
+*  @Description : object lookup and iteration, flat members against std::map
+*  @Datatime : 2026/10/19 12:05:37
+*  @Author : xushun
+*/
+#include "../json.hh"
+#include <chrono>
+#include <cstdio>
+#include <map>
+
+using json = xushun::json;
+
+static double nowSec() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count() / 1e9;
+}
+
+// best of 5, in ns per operation
+template<typename F>
+double best(size_t ops, F f) {
+    double sec = 1e9;
+    for (int round = 0; round < 5; ++ round) {
+        double start = nowSec();
+        f();
+        sec = std::min(sec, nowSec() - start);
+    }
+    return sec * 1e9 / ops;
+}
+
+void bench(int size, int count) {
+    std::vector<std::string> keys;
+    for (int i = 0; i < size; ++ i) {
+        keys.push_back(i % 3 == 0 ? "field_" + std::to_string(i) : "f" + std::to_string(i * 7919 % 1000));
+    }
+    std::string doc = "[";
+    for (int r = 0; r < count; ++ r) {
+        doc += r > 0 ? ",{" : "{";
+        for (int i = 0; i < size; ++ i) {
+            doc += (i > 0 ? ",\"" : "\"") + keys[i] + "\":" + std::to_string(r + i);
+        }
+        doc += "}";
+    }
+    doc += "]";
+    json flat;
+    flat.parse(doc);
+    // the storage objects had before: one tree node per member, built in parse order
+    std::vector<std::map<std::string, json>> trees(count);
+    for (int r = 0; r < count; ++ r) {
+        for (int i = 0; i < size; ++ i) {
+            trees[r].insert({keys[i], json((double)(r + i))});
+        }
+    }
+    const std::string& a = keys[0];
+    const std::string& b = keys[size / 2];
+    const std::string& c = keys[size - 1];
+    double sumTree = 0, sumFlat = 0;
+    double treeFind = best(count * 3, [&]() {
+        for (auto& tree : trees) {
+            sumTree += tree.find(a)->second.getNumber() + tree.find(b)->second.getNumber() + tree.find(c)->second.getNumber();
+        }
+    });
+    double flatFind = best(count * 3, [&]() {
+        for (size_t r = 0; r < flat.getArraySize(); ++ r) {
+            json& o = flat[r];
+            sumFlat += o[a].getNumber() + o[b].getNumber() + o[c].getNumber();
+        }
+    });
+    double treeIter = best(count * size, [&]() {
+        for (auto& tree : trees) {
+            for (auto& pr : tree) { sumTree += pr.second.getNumber(); }
+        }
+    });
+    double flatIter = best(count * size, [&]() {
+        for (size_t r = 0; r < flat.getArraySize(); ++ r) {
+            json& o = flat[r];
+            for (size_t i = 0; i < o.getObjectSize(); ++ i) { sumFlat += o.getObjectValue(i).getNumber(); }
+        }
+    });
+    printf("%5d keys x %6d   find map %6.1f ns  flat %6.1f ns   iterate map %5.2f ns  flat %5.2f ns   %s\n",
+        size, count, treeFind, flatFind, treeIter, flatIter, sumTree == sumFlat ? "same" : "DIFFERENT");
+}
+
+int main(int argc, char** argv) {
+
+    bench(5, 200000);
+    bench(10, 100000);
+    bench(30, 30000);
+    bench(100, 10000);
+    bench(1000, 1000);
+
+    return 0;
+}
@@ -0,0 +1,98 @@
+/*
+*  @Filename : bench_13_keys.cc
+*  @Description : memory of object keys in a large array of records
+*  @Datatime : 2026/10/20 09:37:14
+*  @Author : xushun
+*/
+#include "../json.hh"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+using json = xushun::json;
+
+// every allocation carries its size so that live bytes can be tracked
+static size_t liveBytes = 0;
+void* operator new(size_t size) {
+    size_t* p = (size_t*)malloc(size + sizeof(size_t) * 2);
+    if (p == nullptr) { throw std::bad_alloc(); }
+    p[0] = size;
+    liveBytes += size;
+    return p + 2;
+}
+void operator delete(void* ptr) noexcept {
+    if (ptr == nullptr) { return; }
+    size_t* p = (size_t*)ptr - 2;
+    liveBytes -= p[0];
+    free(p);
+}
+
+static double nowSec() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count() / 1e9;
+}
+
+// 20 keys per record, 12 of them longer than 15 chars
+static const char* keys[20] = {
+    "id", "name", "email", "age", "city", "zip", "active", "score",
+    "customer_identifier", "registration_timestamp", "last_login_timestamp", "preferred_language",
+    "shipping_address_line", "billing_address_line", "marketing_opt_in_flag", "account_balance_cents",
+    "loyalty_program_level", "referral_source_channel", "number_of_orders_placed", "average_order_value",
+};
+
+std::string recordsDoc(int count) {
+    std::string doc = "[";
+    for (int i = 0; i < count; ++ i) {
+        doc += i > 0 ? ",{" : "{";
+        for (int k = 0; k < 20; ++ k) {
+            if (k > 0) { doc += ","; }
+            doc += "\"";
+            doc += keys[k];
+            doc += "\":" + std::to_string((i + k) % 1000);
+        }
+        doc += "}";
+    }
+    return doc + "]";
+}
+
+// what every member cost with a std::string key
+typedef std::vector<std::vector<std::pair<std::string, json>>> stringKeyed;
+
+void report(const char* name, size_t bytes, double sec, int count) {
+    printf("%-14s %8.1f MB   %7.1f B/record   parse %7.1f ms\n", name, bytes / 1e6, (double)bytes / count, sec * 1e3);
+}
+
+int main(int argc, char** argv) {
+
+    int count = argc > 1 ? atoi(argv[1]) : 1000000;
+    std::string doc = recordsDoc(count);
+    printf("%d records, %.1f MB\n", count, doc.size() / 1e6);
+
+    for (int useArena = 0; useArena < 2; ++ useArena) {
+        size_t before = liveBytes;
+        json* j = new json();
+        if (useArena) { j->setArena(); }
+        double start = nowSec();
+        j->parse(doc);
+        double sec = nowSec() - start;
+        report(useArena ? "arena, pooled" : "heap", liveBytes - before, sec, count);
+        if (!useArena) {
+            // the same members with std::string keys
+            size_t baseBefore = liveBytes;
+            stringKeyed* base = new stringKeyed(count);
+            for (int i = 0; i < count; ++ i) {
+                json& record = (*j)[i];
+                (*base)[i].reserve(record.getObjectSize());
+                for (size_t k = 0; k < record.getObjectSize(); ++ k) {
+                    (*base)[i].emplace_back(record.getObjectKey(k).toString(), record.getObjectValue(k).getNumber());
+                }
+            }
+            report("string keys", liveBytes - baseBefore + sizeof(json) * (count + 1), 0, count);
+            delete base;
+        }
+        delete j;
+    }
+
+    return 0;
+}
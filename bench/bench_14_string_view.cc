@@ -0,0 +1,78 @@
+/*
+*  @Filename : bench_14_string_view.cc
+*  @Description : allocations of reading string fields, getString against getStringView
+*  @Datatime : 2026/10/20 14:05:51
+*  @Author : xushun
+*/
+#include "../json.hh"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+using json = xushun::json;
+
+static size_t allocations = 0;
+void* operator new(size_t size) {
+    ++ allocations;
+    void* p = malloc(size);
+    if (p == nullptr) { throw std::bad_alloc(); }
+    return p;
+}
+void operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+
+static double nowSec() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count() / 1e9;
+}
+
+const int N = 200000;
+
+// short codes and longer text, as in typical records
+std::string recordsDoc() {
+    std::string doc = "[";
+    for (int i = 0; i < N; ++ i) {
+        if (i > 0) { doc += ","; }
+        doc += "{\"code\":\"C" + std::to_string(i % 1000) + "\",\"state\":\"open\",\"lang\":\"zh-CN\","
+             "\"title\":\"order number " + std::to_string(i) + " for the west lake store\"}";
+    }
+    return doc + "]";
+}
+
+static const char* fields[4] = {"code", "state", "lang", "title"};
+
+int main(int argc, char** argv) {
+
+    std::string doc = recordsDoc();
+    size_t before = allocations;
+    json j;
+    j.parse(doc);
+    printf("parse           %8.2f allocations/string\n", (double)(allocations - before) / (N * 4));
+
+    size_t bytes = 0;
+    before = allocations;
+    double start = nowSec();
+    for (int i = 0; i < N; ++ i) {
+        for (const char* field : fields) {
+            bytes += j[i][field].getString().size();
+        }
+    }
+    double sec = nowSec() - start;
+    printf("getString       %8.2f allocations/read   %6.1f ns/read\n",
+        (double)(allocations - before) / (N * 4), sec * 1e9 / (N * 4));
+
+    before = allocations;
+    start = nowSec();
+    for (int i = 0; i < N; ++ i) {
+        for (const char* field : fields) {
+            bytes += j[i][field].getStringView().size();
+        }
+    }
+    sec = nowSec() - start;
+    printf("getStringView   %8.2f allocations/read   %6.1f ns/read   (%zu)\n",
+        (double)(allocations - before) / (N * 4), sec * 1e9 / (N * 4), bytes);
+
+    return 0;
+}
@@ -0,0 +1,69 @@
+/*
+*  @Filename : bench_15_lazy.cc
+*  @Description : reading three fields of a large document, tree against on-demand
+*  @Datatime : 2026/10/20 17:03:45
+*  @Author : xushun
+*/
+#include "../json.hh"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+using json = xushun::json;
+
+static size_t allocations = 0;
+void* operator new(size_t size) {
+    ++ allocations;
+    void* p = malloc(size);
+    if (p == nullptr) { throw std::bad_alloc(); }
+    return p;
+}
+void operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+
+static double nowSec() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count() / 1e9;
+}
+
+std::string largeDoc(int count) {
+    std::string doc = "{\"records\":[";
+    for (int i = 0; i < count; ++ i) {
+        if (i > 0) { doc += ","; }
+        doc += "{\"id\":" + std::to_string(i) + ",\"name\":\"customer number " + std::to_string(i)
+             + "\",\"tags\":[\"a\",\"bb\",\"a longer tag value\"],\"address\":{\"city\":\"Hangzhou\",\"zip\":310000}}";
+    }
+    return doc + "],\"meta\":{\"version\":3,\"source\":\"export\"}}";
+}
+
+int main(int argc, char** argv) {
+
+    std::string doc = largeDoc(300000);
+    printf("%.2f MB\n", doc.size() / 1e6);
+    double sum = 0;
+
+    for (int round = 0; round < 2; ++ round) {
+        size_t before = allocations;
+        double start = nowSec();
+        if (round == 0) {
+            json j;
+            j.parse(doc);
+            sum += j["meta"]["version"].getNumber();
+            sum += j["records"][150000]["address"]["zip"].getNumber();
+            sum += j["records"][299999]["name"].getString().size();
+        } else {
+            json::lazyValue v;
+            v.parse(doc);
+            sum += v["meta"]["version"].getNumber();
+            sum += v["records"][150000]["address"]["zip"].getNumber();
+            sum += v["records"][299999]["name"].getString().size();
+        }
+        double sec = nowSec() - start;
+        printf("%-6s %8.1f ms   %9zu allocations\n", round == 0 ? "tree" : "lazy", sec * 1e3, allocations - before);
+    }
+    printf("(%.0f)\n", sum);
+
+    return 0;
+}
@@ -0,0 +1,94 @@
+/*
+*  @Filename : bench_16_indexed.cc
+*  @Description : the structural index alone, and parsing with and without it
+*  @Datatime : 2026/10/21 11:12:40
+*  @Author : xushun
+*/
+#include "../json.hh"
+#include <chrono>
+#include <cstdio>
+
+using json = xushun::json;
+
+static double nowSec() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count() / 1e9;
+}
+
+// records of short fields, or of one long text each
+std::string largeDoc(int count, bool text) {
+    std::string doc = "{\"records\": [\n";
+    for (int i = 0; i < count; ++ i) {
+        if (i > 0) { doc += ",\n"; }
+        std::string name = i % 10 == 0 ? "customer \\\"" + std::to_string(i) + "\\\"" : "customer " + std::to_string(i);
+        if (text) {
+            doc += "    {\"id\": " + std::to_string(i) + ", \"text\": \"" + name;
+            for (int k = 0; k < 8; ++ k) { doc += " and the quick brown fox jumps over the lazy dog"; }
+            doc += "\"}";
+        } else {
+            doc += "    {\"id\": " + std::to_string(i) + ", \"name\": \"" + name + "\", \"score\": " + std::to_string(i * 0.37)
+                 + ", \"active\": true, \"tags\": [\"a\", \"bb\", \"a longer tag value\"], \"address\": {\"city\": \"Hangzhou\", \"zip\": null}}";
+        }
+    }
+    return doc + "\n]}";
+}
+
+struct countHandler : json::handler {
+    size_t values = 0;
+    bool null() { ++ values; return true; }
+    bool boolean(bool) { ++ values; return true; }
+    bool number(double) { ++ values; return true; }
+    bool string(const xushun::stringView&) { ++ values; return true; }
+};
+
+const int ROUNDS = 5;
+
+int main(int argc, char** argv) {
+
+    printf("index engine %s\n", json::indexEngine());
+    for (int text = 0; text < 2; ++ text) {
+        std::string doc = largeDoc(text ? 60000 : 200000, text != 0);
+        double mb = doc.size() / 1e6;
+        printf("%s, %.2f MB\n", text ? "long text" : "short fields", mb);
+
+        std::vector<uint32_t> tape;
+        double start = nowSec();
+        for (int r = 0; r < ROUNDS; ++ r) {
+            xushun::indexStructure(doc.data(), doc.size(), tape);
+        }
+        double sec = (nowSec() - start) / ROUNDS;
+        printf("  index only      %8.2f GB/s   %zu tokens\n", mb / 1e3 / sec, tape.size());
+
+        for (int indexed = 0; indexed < 2; ++ indexed) {
+            countHandler h;
+            start = nowSec();
+            for (int r = 0; r < ROUNDS; ++ r) {
+                if (indexed) {
+                    json::parseIndexed(doc.data(), doc.size(), h);
+                } else {
+                    json::parse(doc.data(), doc.size(), h);
+                }
+            }
+            sec = (nowSec() - start) / ROUNDS;
+            printf("  sax %-9s   %8.1f MB/s\n", indexed ? "indexed" : "recursive", mb / sec);
+        }
+
+        for (int indexed = 0; indexed < 2; ++ indexed) {
+            size_t size = 0;
+            start = nowSec();
+            for (int r = 0; r < ROUNDS; ++ r) {
+                json j;
+                if (indexed) {
+                    j.parseIndexed(doc);
+                } else {
+                    j.parse(doc);
+                }
+                size += j["records"].getArraySize();
+            }
+            sec = (nowSec() - start) / ROUNDS;
+            printf("  dom %-9s   %8.1f MB/s   (%zu)\n", indexed ? "indexed" : "recursive", mb / sec, size / ROUNDS);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,78 @@
+/*
+*  @Filename : bench_17_cbor.cc
+*  @Description : size and speed of CBOR against text JSON
+*  @Datatime : 2026/10/21 16:20:05
+*  @Author : xushun
+*/
+#include "../json.hh"
+#include <chrono>
+#include <cstdio>
+
+using json = xushun::json;
+
+static double nowSec() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count() / 1e9;
+}
+
+// a service payload: ids, measurements and short text
+std::string recordsDoc(int count) {
+    std::string doc = "[";
+    for (int i = 0; i < count; ++ i) {
+        if (i > 0) { doc += ","; }
+        doc += "{\"id\":" + std::to_string(100000 + i) + ",\"price\":" + std::to_string(i * 0.01 + 0.99)
+             + ",\"ratio\":" + std::to_string(1.0 / (i + 3)) + ",\"qty\":" + std::to_string(i % 50)
+             + ",\"sku\":\"SKU-" + std::to_string(i) + "\",\"note\":\"line \\\"" + std::to_string(i)
+             + "\\\" of the order\",\"paid\":true,\"coupon\":null}";
+    }
+    return doc + "]";
+}
+
+struct countHandler : json::handler {
+    size_t values = 0;
+    bool null() { ++ values; return true; }
+    bool boolean(bool) { ++ values; return true; }
+    bool number(double) { ++ values; return true; }
+    bool string(const xushun::stringView&) { ++ values; return true; }
+};
+
+const int ROUNDS = 5;
+
+int main(int argc, char** argv) {
+
+    json j;
+    j.parse(recordsDoc(200000));
+    std::string text = j.dump(), cbor = j.dumpCbor();
+    printf("size     text %8.2f MB   cbor %8.2f MB   (%.0f%%)\n", text.size() / 1e6, cbor.size() / 1e6, 100.0 * cbor.size() / text.size());
+
+    double sec[2][3];
+    for (int binary = 0; binary < 2; ++ binary) {
+        std::string out;
+        double start = nowSec();
+        for (int r = 0; r < ROUNDS; ++ r) {
+            out.clear();
+            if (binary) { j.dumpCbor(out); } else { out = j.dump(); }
+        }
+        sec[binary][0] = (nowSec() - start) / ROUNDS;
+
+        start = nowSec();
+        for (int r = 0; r < ROUNDS; ++ r) {
+            json back;
+            if (binary) { back.parseCbor(xushun::stringView(cbor)); } else { back.parse(text); }
+        }
+        sec[binary][1] = (nowSec() - start) / ROUNDS;
+
+        countHandler h;
+        start = nowSec();
+        for (int r = 0; r < ROUNDS; ++ r) {
+            if (binary) { json::parseCbor(cbor.data(), cbor.size(), h); } else { json::parse(text.data(), text.size(), h); }
+        }
+        sec[binary][2] = (nowSec() - start) / ROUNDS;
+    }
+    const char* names[3] = {"encode", "decode", "decode (sax)"};
+    for (int k = 0; k < 3; ++ k) {
+        printf("%-12s text %8.1f ms   cbor %8.1f ms   (x%.1f)\n", names[k], sec[0][k] * 1e3, sec[1][k] * 1e3, sec[0][k] / sec[1][k]);
+    }
+
+    return 0;
+}
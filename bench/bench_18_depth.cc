@@ -0,0 +1,87 @@
+/*
+*  @Filename : bench_18_depth.cc
+*  @Description : the walks over a tree on their own stacks, and hostile nesting
+*  @Datatime : 2026/10/21 20:31:08
+*  @Author : xushun
+*/
+#include "../json.hh"
+#include <chrono>
+#include <cstdio>
+
+using json = xushun::json;
+
+static double nowSec() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count() / 1e9;
+}
+
+// flat records, or small containers inside one another
+std::string doc(bool nested) {
+    std::string s = "[";
+    for (int i = 0; i < (nested ? 300000 : 200000); ++ i) {
+        if (i > 0) { s += ","; }
+        if (nested) {
+            s += "[[1,2],{\"k\":[3,{\"x\":[]}]}]";
+        } else {
+            s += "{\"id\":" + std::to_string(i) + ",\"name\":\"customer " + std::to_string(i) + "\",\"score\":"
+               + std::to_string(i * 0.37) + ",\"active\":true,\"tags\":[\"a\",\"bb\",\"a longer tag value\"],"
+               + "\"address\":{\"city\":\"Hangzhou\",\"zip\":null}}";
+        }
+    }
+    return s + "]";
+}
+
+struct countHandler : json::handler {
+    size_t values = 0;
+    bool number(double) { ++ values; return true; }
+    bool string(const xushun::stringView&) { ++ values; return true; }
+};
+
+const int ROUNDS = 5;
+
+int main(int argc, char** argv) {
+
+    const char* ops[6] = {"parse", "sax", "dump", "isEqual", "copy", "destroy"};
+    for (int nested = 0; nested < 2; ++ nested) {
+        std::string text = doc(nested != 0);
+        printf("%s, %.2f MB\n", nested ? "nested" : "records", text.size() / 1e6);
+        double best[6] = {1e9, 1e9, 1e9, 1e9, 1e9, 1e9};
+        for (int r = 0; r < ROUNDS; ++ r) {
+            double start = nowSec();
+            json* a = new json;
+            a->parse(text);
+            best[0] = std::min(best[0], nowSec() - start);
+            countHandler h;
+            start = nowSec();
+            json::parse(text.data(), text.size(), h);
+            best[1] = std::min(best[1], nowSec() - start);
+            start = nowSec();
+            std::string out = a->dump();
+            best[2] = std::min(best[2], nowSec() - start);
+            start = nowSec();
+            json* b = new json(*a);
+            best[4] = std::min(best[4], nowSec() - start);
+            start = nowSec();
+            bool equal = a->isEqual(*b);
+            best[3] = std::min(best[3], nowSec() - start);
+            start = nowSec();
+            delete a;
+            best[5] = std::min(best[5], nowSec() - start);
+            delete b;
+            if (!equal || out.empty()) { printf("  mismatch\n"); }
+        }
+        for (int k = 0; k < 6; ++ k) {
+            printf("  %-8s %8.1f ms\n", ops[k], best[k] * 1e3);
+        }
+    }
+
+    // refused at the limit instead of a stack overflow
+    std::string hostile(1000000, '[');
+    json j;
+    double start = nowSec();
+    json::jsonError ret = j.parse(hostile);
+    printf("1000000 x '[' %s in %.3f ms (limit %zu)\n", ret == json::JSON_PARSE_DEPTH_EXCEEDED ? "refused" : "accepted",
+        (nowSec() - start) * 1e3, json::getMaxDepth());
+
+    return 0;
+}
@@ -0,0 +1,70 @@
+/*
+*  @Filename : bench_19_writer.cc
+*  @Description : dump() into one string against json::writer in blocks
+*  @Datatime : 2026/10/22 10:05:31
+*  @Author : xushun
+*/
+#include "../json.hh"
+#include <chrono>
+#include <cstdio>
+
+using json = xushun::json;
+
+static double nowSec() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count() / 1e9;
+}
+
+std::string recordsDoc(int count) {
+    std::string doc = "[";
+    for (int i = 0; i < count; ++ i) {
+        if (i > 0) { doc += ","; }
+        doc += "{\"id\":" + std::to_string(100000 + i) + ",\"price\":" + std::to_string(i * 0.01 + 0.99)
+             + ",\"sku\":\"SKU-" + std::to_string(i) + "\",\"note\":\"line \\\"" + std::to_string(i)
+             + "\\\" of the order\",\"tags\":[\"a\",\"bb\"],\"paid\":true}";
+    }
+    return doc + "]";
+}
+
+const int ROUNDS = 5;
+
+int main(int argc, char** argv) {
+
+    json j;
+    j.parse(recordsDoc(600000));
+    FILE* devnull = fopen("/dev/null", "wb");
+    double best[3] = {1e9, 1e9, 1e9};
+    size_t size = 0;
+    for (int r = 0; r < ROUNDS; ++ r) {
+        // the whole text first, then out
+        double start = nowSec();
+        std::string out = j.dump();
+        fwrite(out.data(), 1, out.size(), devnull);
+        best[0] = std::min(best[0], nowSec() - start);
+        size = out.size();
+        out = std::string();
+
+        start = nowSec();
+        {
+            json::writer w(devnull);
+            w.write(j);
+        }
+        best[1] = std::min(best[1], nowSec() - start);
+
+        size_t bytes = 0;
+        start = nowSec();
+        {
+            json::writer w([&bytes](const char*, size_t len) { bytes += len; return true; });
+            w.write(j);
+        }
+        best[2] = std::min(best[2], nowSec() - start);
+    }
+    fclose(devnull);
+    double mb = size / 1e6;
+    printf("%.1f MB of text\n", mb);
+    printf("dump() + fwrite    %8.1f MB/s   holds %8.1f MB\n", mb / best[0], mb);
+    printf("writer(FILE*)      %8.1f MB/s   holds %8.1f MB\n", mb / best[1], 2 * 65536 / 1e6);
+    printf("writer(callback)   %8.1f MB/s   holds %8.1f MB\n", mb / best[2], 2 * 65536 / 1e6);
+
+    return 0;
+}
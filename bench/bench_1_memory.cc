@@ -0,0 +1,94 @@
+/*
+*  @Filename : bench_1_memory.cc
+*  @Description : bytes per node of the value layout
+*  @Datatime : 2026/10/18 10:12:31
+*  @Author : xushun
+*/
+#include "../json.hh"
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+using json = xushun::json;
+
+// every allocation carries its size so that live bytes can be tracked
+static size_t liveBytes = 0;
+void* operator new(size_t size) {
+    size_t* p = (size_t*)malloc(size + sizeof(size_t) * 2);
+    if (p == nullptr) { throw std::bad_alloc(); }
+    p[0] = size;
+    liveBytes += size;
+    return p + 2;
+}
+void operator delete(void* ptr) noexcept {
+    if (ptr == nullptr) { return; }
+    size_t* p = (size_t*)ptr - 2;
+    liveBytes -= p[0];
+    free(p);
+}
+
+// the node layout before the tagged union: every member is always present
+struct legacyJson {
+    std::string dumpedString_;
+    json::jsonType type_;
+    std::map<std::string, legacyJson> object_;
+    std::vector<legacyJson> array_;
+    std::string string_;
+    double number_;
+};
+
+const int N = 1000000;
+
+void report(const char* name, size_t nodeSize, size_t bytes, size_t nodes) {
+    printf("%-28s sizeof %4zu B   heap %8.2f B/node\n", name, nodeSize, (double)bytes / nodes);
+}
+
+void benchLegacy() {
+    size_t before = liveBytes;
+    std::vector<legacyJson>* arr = new std::vector<legacyJson>(N);
+    for (int i = 0; i < N; ++ i) {
+        (*arr)[i].type_ = json::JSON_NUMBER;
+        (*arr)[i].number_ = i;
+    }
+    report("legacy number array", sizeof(legacyJson), liveBytes - before, N);
+    delete arr;
+}
+
+void benchNumbers() {
+    std::string doc = "[";
+    for (int i = 0; i < N; ++ i) {
+        if (i > 0) { doc += ","; }
+        doc += std::to_string(i);
+    }
+    doc += "]";
+    size_t before = liveBytes;
+    json* j = new json();
+    j->parse(doc);
+    report("number array", sizeof(json), liveBytes - before, N);
+    delete j;
+}
+
+void benchRecords() {
+    std::string doc = "[";
+    for (int i = 0; i < N / 10; ++ i) {
+        if (i > 0) { doc += ","; }
+        doc += "{\"id\":" + std::to_string(i) + ",\"ok\":true,\"tag\":null,\"name\":\"n\"}";
+    }
+    doc += "]";
+    size_t before = liveBytes;
+    json* j = new json();
+    j->parse(doc);
+    // one record node plus four members
+    report("record array", sizeof(json), liveBytes - before, N / 10 * 5);
+    delete j;
+}
+
+
+int main(int argc, char** argv) {
+
+    benchLegacy();
+    benchNumbers();
+    benchRecords();
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+/*
+*  @Filename : bench_20_context.cc
+*  @Description : many small messages through json::parser and json::serializer
+*  @Datatime : 2026/10/22 14:40:17
+*  @Author : xushun
+*/
+#include "../json.hh"
+#include <chrono>
+#include <cstdio>
+
+using json = xushun::json;
+
+// every allocation is counted
+static size_t allocations = 0;
+void* operator new(size_t size) {
+    ++ allocations;
+    void* p = malloc(size);
+    if (p == nullptr) { throw std::bad_alloc(); }
+    return p;
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+static double nowSec() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count() / 1e9;
+}
+
+struct countHandler : json::handler {
+    size_t values = 0;
+    bool number(double) { ++ values; return true; }
+    bool string(const xushun::stringView&) { ++ values; return true; }
+};
+
+const int MESSAGES = 200000;
+
+int main(int argc, char** argv) {
+
+    // a request with escapes, so the parse needs its string stack too
+    std::string message = "{\"method\":\"order.create\",\"id\":12345,\"params\":{\"sku\":\"SKU-\\\"42\\\"\","
+                          "\"qty\":3,\"price\":19.99,\"tags\":[\"a\",\"bb\"],\"note\":\"line one\\nline two\"}}";
+    countHandler h;
+    for (int reuse = 0; reuse < 2; ++ reuse) {
+        json::parser parser;
+        json::serializer serializer;
+        json j;
+        size_t bytes = 0;
+        // the first message sizes the buffers
+        parser.parse(j, message.data(), message.size());
+        serializer.dump(j);
+        size_t before = allocations;
+        double start = nowSec();
+        for (int i = 0; i < MESSAGES; ++ i) {
+            if (reuse) {
+                parser.parse(j, message.data(), message.size());
+                bytes += serializer.dump(j).size();
+            } else {
+                j.parse(message);
+                bytes += j.dump().size();
+            }
+        }
+        double sec = nowSec() - start;
+        size_t dom = allocations - before;
+
+        before = allocations;
+        start = nowSec();
+        for (int i = 0; i < MESSAGES; ++ i) {
+            if (reuse) {
+                parser.parse(message.data(), message.size(), h);
+            } else {
+                json::parse(message.data(), message.size(), h);
+            }
+        }
+        double saxSec = nowSec() - start;
+        size_t sax = allocations - before;
+        printf("%-20s parse+dump %6.0f ns  %5.1f allocations   sax %6.0f ns  %5.1f allocations   (%zu)\n",
+            reuse ? "parser, serializer" : "parse(), dump()", sec * 1e9 / MESSAGES, (double)dom / MESSAGES,
+            saxSec * 1e9 / MESSAGES, (double)sax / MESSAGES, bytes / MESSAGES);
+    }
+
+    return 0;
+}
@@ -0,0 +1,67 @@
+/*
+*  @Filename : bench_21_parallel.cc
+*  @Description : one large top-level array, parse against parseParallel from 1 to N threads
+*  @Datatime : 2026/10/23 11:20:44
+*  @Author : xushun
+*/
+#include "../json.hh"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+using json = xushun::json;
+
+static double nowSec() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count() / 1e9;
+}
+
+// independent records, the strings hold commas and brackets
+std::string recordsDoc(int count) {
+    std::string doc = "[";
+    for (int i = 0; i < count; ++ i) {
+        if (i > 0) { doc += ",\n"; }
+        doc += "{\"id\":" + std::to_string(100000 + i) + ",\"price\":" + std::to_string(i * 0.01 + 0.99)
+             + ",\"sku\":\"SKU-" + std::to_string(i) + "\",\"note\":\"a, [b] {\\\"c\\\"}\",\"tags\":[\"x\",\"y\"],"
+             + "\"paid\":true,\"coupon\":null}";
+    }
+    return doc + "]";
+}
+
+const int ROUNDS = 5;
+
+int main(int argc, char** argv) {
+
+    std::string doc = recordsDoc(500000);
+    // up to one thread per core, or as many as asked for
+    unsigned cores = argc > 1 ? atoi(argv[1]) : std::max(1u, std::thread::hardware_concurrency());
+    printf("%.2f MB, %u threads at most\n", doc.size() / 1e6, cores);
+
+    double start = nowSec();
+    for (int r = 0; r < ROUNDS; ++ r) {
+        json j;
+        j.parse(doc);
+    }
+    double base = (nowSec() - start) / ROUNDS;
+    printf("%-24s %8.1f MB/s\n", "parse", doc.size() / base / 1e6);
+
+    std::vector<unsigned> counts;
+    for (unsigned threads = 1; threads < cores; threads *= 2) { counts.push_back(threads); }
+    counts.push_back(cores);
+    for (unsigned threads : counts) {
+        size_t size = 0;
+        start = nowSec();
+        for (int r = 0; r < ROUNDS; ++ r) {
+            json j;
+            j.parseParallel(doc.data(), doc.size(), threads);
+            size = j.getArraySize();
+        }
+        double sec = (nowSec() - start) / ROUNDS;
+        char name[32];
+        snprintf(name, sizeof(name), "parseParallel %u threads", threads);
+        printf("%-24s %8.1f MB/s   x%.2f   %zu elements\n", name, doc.size() / sec / 1e6, base / sec, size);
+    }
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+/*
+*  @Filename : bench_22_dump_parallel.cc
+*  @Description : dump() against dumpParallel and a parallel writer from 1 to N threads
+*  @Datatime : 2026/10/23 15:02:36
+*  @Author : xushun
+*/
+#include "../json.hh"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+using json = xushun::json;
+
+static double nowSec() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count() / 1e9;
+}
+
+// a result set under a key, next to a few small members
+std::string resultDoc(int count) {
+    std::string doc = "{\"query\":\"orders\",\"rows\":[";
+    for (int i = 0; i < count; ++ i) {
+        if (i > 0) { doc += ","; }
+        doc += "{\"id\":" + std::to_string(100000 + i) + ",\"price\":" + std::to_string(i * 0.01 + 0.99)
+             + ",\"sku\":\"SKU-" + std::to_string(i) + "\",\"note\":\"line \\\"" + std::to_string(i)
+             + "\\\" of the order\",\"tags\":[\"a\",\"bb\"],\"paid\":true}";
+    }
+    return doc + "],\"total\":" + std::to_string(count) + "}";
+}
+
+const int ROUNDS = 5;
+
+int main(int argc, char** argv) {
+
+    json j;
+    j.parse(resultDoc(600000));
+    // up to one thread per core, or as many as asked for
+    unsigned cores = argc > 1 ? atoi(argv[1]) : std::max(1u, std::thread::hardware_concurrency());
+
+    double base = 1e9;
+    std::string expect;
+    for (int r = 0; r < ROUNDS; ++ r) {
+        double start = nowSec();
+        expect = j.dump();
+        base = std::min(base, nowSec() - start);
+    }
+    double mb = expect.size() / 1e6;
+    printf("%.1f MB of text, %u threads at most\n", mb, cores);
+    printf("%-28s %8.1f MB/s\n", "dump()", mb / base);
+
+    std::vector<unsigned> counts;
+    for (unsigned threads = 1; threads < cores; threads *= 2) { counts.push_back(threads); }
+    counts.push_back(cores);
+    for (unsigned threads : counts) {
+        double best[2] = {1e9, 1e9};
+        bool same = true;
+        for (int r = 0; r < ROUNDS; ++ r) {
+            double start = nowSec();
+            std::string out = j.dumpParallel(threads);
+            best[0] = std::min(best[0], nowSec() - start);
+            same = same && out == expect;
+
+            size_t bytes = 0;
+            start = nowSec();
+            {
+                json::writer w([&bytes](const char*, size_t len) { bytes += len; return true; });
+                w.write(j, threads);
+            }
+            best[1] = std::min(best[1], nowSec() - start);
+            same = same && bytes == expect.size();
+        }
+        char name[2][40];
+        snprintf(name[0], sizeof(name[0]), "dumpParallel %u threads", threads);
+        snprintf(name[1], sizeof(name[1]), "writer %u threads", threads);
+        for (int k = 0; k < 2; ++ k) {
+            printf("%-28s %8.1f MB/s   x%.2f%s\n", name[k], mb / best[k], base / best[k], same ? "" : "   MISMATCH");
+        }
+    }
+
+    return 0;
+}
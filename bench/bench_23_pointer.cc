@@ -0,0 +1,101 @@
+/*
+*  @Filename : bench_23_pointer.cc
+*  @Description : a nested field by chained operator[] against a compiled json pointer,
+*                 and out of unparsed text lazily and by events
+*  @Datatime : 2026/10/23 18:04:51
+*  @Author : xushun
+*/
+#include "../json.hh"
+#include <chrono>
+#include <cstdio>
+
+using json = xushun::json;
+
+static double nowSec() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count() / 1e9;
+}
+
+// a response with a few hundred orders, the field is in the last one
+std::string responseDoc(int count) {
+    std::string doc = "{\"status\":\"ok\",\"result\":{\"page\":1,\"orders\":[";
+    for (int i = 0; i < count; ++ i) {
+        if (i > 0) { doc += ","; }
+        doc += "{\"id\":" + std::to_string(100000 + i) + ",\"customer\":{\"name\":\"customer " + std::to_string(i)
+             + "\",\"address\":{\"city\":\"city " + std::to_string(i % 17) + "\",\"zip\":\"" + std::to_string(10000 + i)
+             + "\"}},\"lines\":[{\"sku\":\"SKU-1\",\"qty\":2},{\"sku\":\"SKU-2\",\"qty\":1}]}";
+    }
+    return doc + "]}}";
+}
+
+struct lastString : json::handler {
+    std::string value;
+    bool string(const xushun::stringView& str) { value = str.toString(); return true; }
+};
+
+const int LOOKUPS = 1000000;
+const int EXTRACTS = 2000;
+
+int main(int argc, char** argv) {
+
+    const int count = 300;
+    std::string doc = responseDoc(count);
+    json j;
+    j.parse(doc);
+    size_t members[3];
+    members[0] = j["result"]["orders"][count - 1]["customer"]["address"].getObjectSize();
+
+    // what callers did before: a std::string per step, and a missing key is inserted
+    double start = nowSec();
+    size_t hits = 0;
+    for (int i = 0; i < LOOKUPS; ++ i) {
+        json& city = j["result"]["orders"][count - 1]["customer"]["address"]["city"];
+        hits += city.getType() == json::JSON_STRING;
+    }
+    double chained = (nowSec() - start) / LOOKUPS;
+    j["result"]["orders"][count - 1]["customer"]["address"]["country"];
+    members[1] = j["result"]["orders"][count - 1]["customer"]["address"].getObjectSize();
+
+    json::pointer city("/result/orders/" + std::to_string(count - 1) + "/customer/address/city");
+    json::pointer country("/result/orders/" + std::to_string(count - 1) + "/customer/address/province");
+    start = nowSec();
+    for (int i = 0; i < LOOKUPS; ++ i) {
+        json* found = j.find(city);
+        hits += found != nullptr && found->getType() == json::JSON_STRING;
+    }
+    double compiled = (nowSec() - start) / LOOKUPS;
+    j.find(country);
+    members[2] = j["result"]["orders"][count - 1]["customer"]["address"].getObjectSize();
+    printf("tree    operator[] chain   %8.1f ns   members %zu -> %zu after a miss\n", chained * 1e9, members[0], members[1]);
+    printf("tree    pointer            %8.1f ns   members %zu -> %zu after a miss   (x%.1f)\n", compiled * 1e9,
+        members[1], members[2], chained / compiled);
+
+    // the field out of the text, with the whole tree built first or not at all
+    std::string value;
+    start = nowSec();
+    for (int i = 0; i < EXTRACTS; ++ i) {
+        json k;
+        k.parse(doc);
+        value = k.find(city)->getString();
+    }
+    double tree = (nowSec() - start) / EXTRACTS;
+    start = nowSec();
+    for (int i = 0; i < EXTRACTS; ++ i) {
+        json::lazyValue lazy;
+        lazy.parse(doc.data(), doc.size());
+        value = lazy.find(city).getString();
+    }
+    double lazy = (nowSec() - start) / EXTRACTS;
+    lastString h;
+    start = nowSec();
+    for (int i = 0; i < EXTRACTS; ++ i) {
+        json::parse(doc.data(), doc.size(), city, h);
+    }
+    double sax = (nowSec() - start) / EXTRACTS;
+    printf("%.1f KB of text, \"%s\" %s\n", doc.size() / 1e3, value.c_str(), value == h.value ? "" : "MISMATCH");
+    printf("text    parse + pointer    %8.1f us\n", tree * 1e6);
+    printf("text    lazy pointer       %8.1f us   (x%.1f)\n", lazy * 1e6, tree / lazy);
+    printf("text    sax pointer        %8.1f us   (x%.1f)\n", sax * 1e6, tree / sax);
+
+    return hits == 2u * LOOKUPS ? 0 : 1;
+}
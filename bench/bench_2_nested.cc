@@ -0,0 +1,67 @@
+/*
+*  @Filename : bench_2_nested.cc
+*  @Description : parse deeply nested documents
+*  @Datatime : 2026/10/18 11:03:47
+*  @Author : xushun
+*/
+#include "../json.hh"
+#include <chrono>
+#include <cstdio>
+
+using json = xushun::json;
+
+static double nowUs() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count() / 1000.0;
+}
+
+std::string nestedArray(int depth) {
+    return std::string(depth, '[') + "1" + std::string(depth, ']');
+}
+
+std::string nestedObject(int depth) {
+    std::string s;
+    for (int i = 0; i < depth; ++ i) { s += "{\"a\":"; }
+    s += "1";
+    s += std::string(depth, '}');
+    return s;
+}
+
+// builds the same tree the way the parser used to: each level is
+// parsed into a temporary and then copied into its parent
+double copyBuild(int depth) {
+    double start = nowUs();
+    json inner(1.0);
+    for (int i = 0; i < depth; ++ i) {
+        json outer;
+        outer.setArray();
+        const json& elem = inner;
+        outer.pushbackArray(elem);
+        inner = outer;
+    }
+    return nowUs() - start;
+}
+
+double parseTime(const std::string& doc) {
+    double start = nowUs();
+    json j;
+    j.parse(doc);
+    return nowUs() - start;
+}
+
+
+int main(int argc, char** argv) {
+
+    // deeper than the default limit
+    json::setMaxDepth(4000);
+    printf("%8s %16s %16s %16s\n", "depth", "array ns/level", "object ns/level", "copy ns/level");
+    for (int depth = 250; depth <= 4000; depth *= 2) {
+        double arr = parseTime(nestedArray(depth));
+        double obj = parseTime(nestedObject(depth));
+        double cpy = copyBuild(depth);
+        printf("%8d %16.1f %16.1f %16.1f\n", depth,
+            arr * 1000 / depth, obj * 1000 / depth, cpy * 1000 / depth);
+    }
+
+    return 0;
+}
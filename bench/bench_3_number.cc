@@ -0,0 +1,73 @@
+/*
+*  @Filename : bench_3_number.cc
+*  @Description : parse number-heavy documents
+*  @Datatime : 2026/10/18 14:41:09
+*  @Author : xushun
+*/
+#include "../json.hh"
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+using json = xushun::json;
+
+static double nowSec() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count() / 1e9;
+}
+
+const int N = 1000000;
+
+// metric style numbers: integers, short decimals and full precision doubles
+std::vector<std::string> makeNumbers() {
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> dist(-1e6, 1e6);
+    std::vector<std::string> nums;
+    char buf[32];
+    for (int i = 0; i < N; ++ i) {
+        switch (i % 3) {
+            case 0: snprintf(buf, sizeof(buf), "%d", (int)(rng() % 100000)); break;
+            case 1: snprintf(buf, sizeof(buf), "%.3f", dist(rng));          break;
+            default: snprintf(buf, sizeof(buf), "%.17g", dist(rng));        break;
+        }
+        nums.push_back(buf);
+    }
+    return nums;
+}
+
+int main(int argc, char** argv) {
+
+    std::vector<std::string> nums = makeNumbers();
+    std::string doc = "[";
+    for (int i = 0; i < N; ++ i) {
+        if (i > 0) { doc += ","; }
+        doc += nums[i];
+    }
+    doc += "]";
+
+    // the previous conversion: one std::string per number, then strtod()
+    double start = nowSec();
+    double sum = 0;
+    size_t pos = 1;
+    while (pos < doc.size()) {
+        size_t end = doc.find_first_of(",]", pos);
+        std::string tok = doc.substr(pos, end - pos);
+        sum += strtod(tok.c_str(), nullptr);
+        pos = end + 1;
+    }
+    double strtodSec = nowSec() - start;
+
+    json j;
+    start = nowSec();
+    j.parse(doc);
+    double parseSec = nowSec() - start;
+    double check = 0;
+    for (size_t i = 0; i < j.getArraySize(); ++ i) { check += j[i].getNumber(); }
+
+    printf("document        %8.2f MB, %d numbers\n", doc.size() / 1e6, N);
+    printf("substr+strtod   %8.1f MB/s   (convert only)\n", doc.size() / strtodSec / 1e6);
+    printf("json::parse     %8.1f MB/s   (convert and build)\n", doc.size() / parseSec / 1e6);
+    printf("sums %s\n", sum == check ? "match" : "differ");
+
+    return 0;
+}
@@ -0,0 +1,58 @@
+/*
+*  @Filename : bench_4_dump_number.cc
+*  @Description : dump number-heavy documents
+*  @Datatime : 2026/10/18 16:05:52
+*  @Author : xushun
+*/
+#include "../json.hh"
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+using json = xushun::json;
+
+static double nowSec() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count() / 1e9;
+}
+
+const int N = 1000000;
+
+int main(int argc, char** argv) {
+
+    std::mt19937_64 rng(11);
+    std::uniform_real_distribution<double> dist(-1e3, 1e3);
+    json j;
+    j.setArray();
+    for (int i = 0; i < N; ++ i) {
+        switch (i % 3) {
+            case 0:  j.pushbackArray(json((double)(rng() % 100000))); break;
+            case 1:  j.pushbackArray(json(dist(rng) / 100));          break;
+            default: j.pushbackArray(json(dist(rng)));                break;
+        }
+    }
+
+    // the previous formatting: sprintf("%.17g") into a temporary std::string
+    double start = nowSec();
+    std::string old = "[";
+    for (size_t i = 0; i < j.getArraySize(); ++ i) {
+        if (i > 0) { old += ","; }
+        char num[32];
+        sprintf(num, "%.17g", j[i].getNumber());
+        old += std::string(num);
+    }
+    old += "]";
+    double sprintfSec = nowSec() - start;
+
+    start = nowSec();
+    std::string out = j.dump();
+    double dumpSec = nowSec() - start;
+
+    json back;
+    back.parse(out);
+    printf("sprintf %%.17g   %8.1f ns/number   %8.2f MB\n", sprintfSec * 1e9 / N, old.size() / 1e6);
+    printf("json::dump      %8.1f ns/number   %8.2f MB\n", dumpSec * 1e9 / N, out.size() / 1e6);
+    printf("round trip %s\n", back.isEqual(j) ? "exact" : "differs");
+
+    return 0;
+}
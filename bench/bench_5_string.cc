@@ -0,0 +1,77 @@
+/*
+*  @Filename : bench_5_string.cc
+*  @Description : parse string-dominated documents
+*  @Datatime : 2026/10/18 17:22:40
+*  @Author : xushun
+*/
+#include "../json.hh"
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+using json = xushun::json;
+
+static double nowSec() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count() / 1e9;
+}
+
+std::string base64Doc(int count, int len) {
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::mt19937 rng(3);
+    std::string doc = "[";
+    for (int i = 0; i < count; ++ i) {
+        if (i > 0) { doc += ","; }
+        doc += "\"";
+        for (int k = 0; k < len; ++ k) { doc += alphabet[rng() % 64]; }
+        doc += "\"";
+    }
+    return doc + "]";
+}
+
+std::string logDoc(int count) {
+    std::string doc = "[";
+    for (int i = 0; i < count; ++ i) {
+        if (i > 0) { doc += ","; }
+        doc += "\"2026-10-18T17:22:40Z INFO GET /api/v1/items?id=" + std::to_string(i)
+             + " served in 12ms by worker-7 \\\"cache hit\\\"\\tupstream=10.0.0.1:8080\"";
+    }
+    return doc + "]";
+}
+
+// the previous string loop: one char at a time through the stack
+double oldScan(const std::string& doc) {
+    double start = nowSec();
+    std::string stack, dst;
+    size_t total = 0;
+    for (size_t i = 0; i < doc.size(); ++ i) {
+        if (doc[i] != '\"') { continue; }
+        for (++ i; doc[i] != '\"'; ++ i) {
+            char ch = doc[i];
+            if (ch == '\\') { ch = doc[++ i]; }
+            stack += ch;
+        }
+        dst = stack.substr(0, stack.size());
+        stack.clear();
+        total += dst.size();
+    }
+    return total > 0 ? nowSec() - start : 0;
+}
+
+void bench(const char* name, const std::string& doc) {
+    double oldSec = oldScan(doc);
+    json j;
+    double start = nowSec();
+    j.parse(doc);
+    double sec = nowSec() - start;
+    printf("%-20s %8.2f MB   per-char loop %8.1f MB/s   json::parse %8.1f MB/s\n",
+        name, doc.size() / 1e6, doc.size() / oldSec / 1e6, doc.size() / sec / 1e6);
+}
+
+int main(int argc, char** argv) {
+
+    bench("base64 blobs", base64Doc(2000, 16 * 1024));
+    bench("log lines", logDoc(300000));
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+/*
+*  @Filename : bench_6_dump_string.cc
+*  @Description : string escaping in dump, per byte vs clean spans
+*  @Datatime : 2026/10/18 18:10:27
+*  @Author : xushun
+*/
+#include "../json.hh"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <algorithm>
+
+using json = xushun::json;
+
+static double nowSec() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count() / 1e9;
+}
+
+// the previous dumpString: one switch and one append per byte
+void oldDumpString(std::string& dumpedString, const std::string& s) {
+    const char hexDigits[] = { '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'};
+    dumpedString += '\"';
+    for (unsigned char ch : s) {
+        switch (ch) {
+            case '\"': dumpedString += "\\\"";   break;
+            case '\\': dumpedString += "\\\\";   break;
+            case '\b': dumpedString += "\\b";    break;
+            case '\f': dumpedString += "\\f";    break;
+            case '\n': dumpedString += "\\n";    break;
+            case '\r': dumpedString += "\\r";    break;
+            case '\t': dumpedString += "\\t";    break;
+            default:
+                if (ch < 0x20) {
+                    dumpedString += "\\u00";
+                    dumpedString += hexDigits[ch >> 4];
+                    dumpedString += hexDigits[ch & 15];
+                } else {
+                    dumpedString += ch;
+                }
+        }
+    }
+    dumpedString += '\"';
+}
+
+void bench(const char* name, int count, int len, int escapeEvery) {
+    std::mt19937 rng(5);
+    json j;
+    j.setArray();
+    for (int i = 0; i < count; ++ i) {
+        std::string s;
+        for (int k = 0; k < len; ++ k) {
+            s += (escapeEvery > 0 && k % escapeEvery == escapeEvery - 1) ? '\n' : (char)(' ' + 1 + rng() % 90);
+            if (s.back() == '\\' || s.back() == '\"') { s.back() = 'x'; }
+        }
+        j.pushbackArray(json(std::move(s)));
+    }
+    // best of three, the first round also pays for page faults
+    double oldSec = 1e9, sec = 1e9;
+    std::string old, out;
+    for (int round = 0; round < 3; ++ round) {
+        double start = nowSec();
+        old = "[";
+        for (int i = 0; i < count; ++ i) {
+            if (i > 0) { old += ","; }
+            oldDumpString(old, j[i].getString());
+        }
+        old += "]";
+        oldSec = std::min(oldSec, nowSec() - start);
+        start = nowSec();
+        out = j.dump();
+        sec = std::min(sec, nowSec() - start);
+    }
+    printf("%-22s per byte %8.1f MB/s   spans %8.1f MB/s   %s\n", name,
+        old.size() / oldSec / 1e6, out.size() / sec / 1e6, old == out ? "identical" : "DIFFERENT");
+}
+
+int main(int argc, char** argv) {
+
+    bench("ascii, no escapes", 20000, 2000, 0);
+    bench("ascii, escape per 80", 20000, 2000, 80);
+    bench("ascii, escape per 8", 20000, 2000, 8);
+
+    return 0;
+}
@@ -0,0 +1,92 @@
+/*
+*  @Filename : bench_7_sax.cc
+*  @Description : event parser against the tree parser
+*  @Datatime : 2026/10/18 19:31:08
+*  @Author : xushun
+*/
+#include "../json.hh"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+using json = xushun::json;
+
+static double nowSec() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count() / 1e9;
+}
+
+// live and peak heap bytes
+static size_t liveBytes = 0, peakBytes = 0;
+void* operator new(size_t size) {
+    size_t* p = (size_t*)malloc(size + sizeof(size_t) * 2);
+    if (p == nullptr) { throw std::bad_alloc(); }
+    p[0] = size;
+    liveBytes += size;
+    if (liveBytes > peakBytes) { peakBytes = liveBytes; }
+    return p + 2;
+}
+void operator delete(void* ptr) noexcept {
+    if (ptr == nullptr) { return; }
+    size_t* p = (size_t*)ptr - 2;
+    liveBytes -= p[0];
+    free(p);
+}
+
+std::string ordersDoc(int count) {
+    std::string doc = "[";
+    for (int i = 0; i < count; ++ i) {
+        if (i > 0) { doc += ","; }
+        doc += "{\"id\":" + std::to_string(i) + ",\"user\":\"user-" + std::to_string(i % 977)
+             + "\",\"price\":" + std::to_string(i % 100) + ".25,\"tags\":[\"a\",\"b\\tc\"],\"paid\":true}";
+    }
+    return doc + "]";
+}
+
+// sums every "price" member
+class priceHandler : public json::handler {
+    public:
+        double sum = 0;
+        bool isPrice = false;
+        bool key(const xushun::stringView& key) override { isPrice = key == "price"; return true; }
+        bool number(double num) override { if (isPrice) { sum += num; } isPrice = false; return true; }
+};
+
+void bench(int count) {
+    std::string doc = ordersDoc(count);
+    size_t base = liveBytes;
+
+    peakBytes = liveBytes;
+    double start = nowSec();
+    priceHandler h;
+    json::parse(xushun::stringView(doc), h);
+    double saxSec = nowSec() - start;
+    size_t saxPeak = peakBytes - base;
+
+    peakBytes = liveBytes;
+    start = nowSec();
+    double sum = 0;
+    {
+        json j;
+        j.parse(doc);
+        for (size_t i = 0; i < j.getArraySize(); ++ i) {
+            sum += j[i]["price"].getNumber();
+        }
+    }
+    double domSec = nowSec() - start;
+    size_t domPeak = peakBytes - base;
+
+    printf("%8.2f MB   sax %8.1f MB/s peak %10zu B   dom %8.1f MB/s peak %10zu B   %s\n",
+        doc.size() / 1e6, doc.size() / saxSec / 1e6, saxPeak, doc.size() / domSec / 1e6, domPeak,
+        h.sum == sum ? "same sum" : "SUM MISMATCH");
+}
+
+int main(int argc, char** argv) {
+
+    bench(10000);
+    bench(100000);
+    bench(1000000);
+
+    return 0;
+}
@@ -0,0 +1,55 @@
+/*
+*  @Filename : bench_8_stream.cc
+*  @Description : chunked parse against the whole buffer parse
+*  @Datatime : 2026/10/18 20:57:16
+*  @Author : xushun
+*/
+#include "../json.hh"
+#include <chrono>
+#include <cstdio>
+
+using json = xushun::json;
+
+static double nowSec() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count() / 1e9;
+}
+
+std::string ordersDoc(int count) {
+    std::string doc = "[";
+    for (int i = 0; i < count; ++ i) {
+        if (i > 0) { doc += ","; }
+        doc += "{\"id\":" + std::to_string(i) + ",\"user\":\"user-" + std::to_string(i % 977)
+             + "\",\"price\":" + std::to_string(i % 100) + ".25,\"note\":\"caf\\u00e9 \\\"ok\\\"\",\"paid\":true}";
+    }
+    return doc + "]";
+}
+
+void bench(const std::string& doc, size_t chunk) {
+    double start = nowSec();
+    json j;
+    json::streamParser parser(j);
+    for (size_t i = 0; i < doc.size(); i += chunk) {
+        parser.feed(doc.data() + i, std::min(chunk, doc.size() - i));
+    }
+    json::jsonError ret = parser.finish();
+    double sec = nowSec() - start;
+    printf("chunk %8zu B   %8.1f MB/s   %s\n", chunk, doc.size() / sec / 1e6,
+        ret == json::JSON_PARSE_OK && j.getArraySize() > 0 ? "ok" : "FAILED");
+}
+
+int main(int argc, char** argv) {
+
+    std::string doc = ordersDoc(300000);
+    double start = nowSec();
+    {
+        json j;
+        j.parse(doc);
+    }
+    printf("whole buffer       %8.1f MB/s   %.2f MB\n", doc.size() / (nowSec() - start) / 1e6, doc.size() / 1e6);
+    for (size_t chunk : {7, 64, 1500, 4096, 65536}) {
+        bench(doc, chunk);
+    }
+
+    return 0;
+}
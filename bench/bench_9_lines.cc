@@ -0,0 +1,70 @@
+/*
+*  @Filename : bench_9_lines.cc
+*  @Description : json lines, split and copy per line against lineReader and parseLines
+*  @Datatime : 2026/10/18 21:46:02
+*  @Author : xushun
+*/
+#include "../json.hh"
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+using json = xushun::json;
+
+static double nowSec() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count() / 1e9;
+}
+
+std::string logLines(int count) {
+    std::string doc;
+    for (int i = 0; i < count; ++ i) {
+        doc += "{\"ts\":" + std::to_string(1760000000 + i) + ",\"level\":\"INFO\",\"path\":\"/api/v1/items\",\"id\":"
+             + std::to_string(i) + ",\"ms\":" + std::to_string(i % 250) + ".5,\"ok\":true}\n";
+    }
+    return doc;
+}
+
+void report(const char* name, const std::string& doc, double sec, size_t records) {
+    printf("%-24s %8.1f MB/s   %zu records\n", name, doc.size() / sec / 1e6, records);
+}
+
+int main(int argc, char** argv) {
+
+    std::string doc = logLines(1000000);
+    printf("%.2f MB, %u cores\n", doc.size() / 1e6, std::thread::hardware_concurrency());
+
+    // what callers did before: getline-style split, copy, parse
+    double start = nowSec();
+    size_t count = 0;
+    for (size_t pos = 0; pos < doc.size(); ) {
+        size_t nl = doc.find('\n', pos);
+        std::string line = doc.substr(pos, nl - pos);
+        json j;
+        j.parse(line);
+        ++ count;
+        pos = nl + 1;
+    }
+    report("split + copy + parse", doc, nowSec() - start, count);
+
+    start = nowSec();
+    count = 0;
+    {
+        json::lineReader reader(doc);
+        json j;
+        while (reader.next(j)) { ++ count; }
+    }
+    report("lineReader", doc, nowSec() - start, count);
+
+    for (unsigned threads : {1u, 2u, 4u, 0u}) {
+        start = nowSec();
+        std::vector<json> records;
+        size_t errorLine;
+        json::parseLines(doc, records, errorLine, threads);
+        char name[32];
+        snprintf(name, sizeof(name), "parseLines %u threads", threads == 0 ? std::thread::hardware_concurrency() : threads);
+        report(name, doc, nowSec() - start, records.size());
+    }
+
+    return 0;
+}
@@ -0,0 +1,38 @@
+/*
+*  @Filename : example_5_sax.cc
+*  @Description : example for the event parser
+*  @Datatime : 2026/10/18 19:44:20
+*  @Author : xushun
+*/
+#include "../json.hh"
+#include <iostream>
+
+using json = xushun::json;
+
+// counts the members named "price" and sums them, no tree is built
+class priceCounter : public json::handler {
+    public:
+        int count = 0;
+        double sum = 0;
+        bool isPrice = false;
+        bool key(const xushun::stringView& key) override {
+            isPrice = key == "price";
+            return true;
+        }
+        bool number(double num) override {
+            if (isPrice) { ++ count; sum += num; }
+            isPrice = false;
+            return true;
+        }
+};
+
+int main(int argc, char** argv) {
+
+    std::string recvBuf = "[{\"item\":\"apple\",\"price\":3.5},{\"item\":\"pear\",\"price\":2}]";
+    priceCounter counter;
+    if (json::parse(recvBuf, counter) == json::JSON_PARSE_OK) {
+        std::cout << counter.count << " prices, sum " << counter.sum << std::endl;
+    }
+
+    return 0;
+}
@@ -11,16 +11,231 @@
 #include <vector>
 #include <string>
 #include <map>
-#include <cerrno>   // strtod()
-#include <cmath>    // HUGE_VAL
+#include <cstdint>
+#include <cstdlib>  // strtod()
+#include <cmath>    // std::isinf()
+#include <cfloat>   // FLT_EVAL_METHOD
+#include <clocale>  // localeconv()
+#include <cstring>  // strlen()
+#include <cstdio>   // sprintf()
+#include <cerrno>
+#include <thread>   // parseLines()
+#include <algorithm>
+#include <atomic>   // arena ids
+#include <mutex>
+#include <new>
+#include <functional> // json::writer
+#include <ostream>
+#include <tuple>    // arenaConstruct
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h> // parseFile()
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#if defined(__AVX2__) || ((defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__))
+#include <immintrin.h> // AVX2 is also picked at runtime, see indexEngine()
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>   // _BitScanForward()
+#endif
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
 
 namespace xushun {
 
+    // non-owning view of a character buffer, need not be NUL-terminated
+    class stringView {
+        private:
+            const char* data_;
+            size_t size_;
+        public:
+            stringView() : data_(""), size_(0) {}
+            stringView(const char* str) : data_(str), size_(strlen(str)) {}
+            stringView(const char* data, size_t size) : data_(data), size_(size) {}
+            stringView(const std::string& str) : data_(str.data()), size_(str.size()) {}
+#if __cplusplus >= 201703L
+            stringView(std::string_view str) : data_(str.data()), size_(str.size()) {}
+            operator std::string_view() const { return std::string_view(data_, size_); }
+#endif
+            const char* data() const { return data_; }
+            size_t size() const { return size_; }
+            bool empty() const { return size_ == 0; }
+            const char* begin() const { return data_; }
+            const char* end() const { return data_ + size_; }
+            char operator[](size_t idx) const { return data_[idx]; }
+            std::string toString() const { return std::string(data_, size_); }
+            bool operator==(const stringView& rhs) const {
+                return size_ == rhs.size_ && memcmp(data_, rhs.data_, size_) == 0;
+            }
+            bool operator!=(const stringView& rhs) const { return !(*this == rhs); }
+    };
+
+
+
+
+    // monotonic memory, nothing is freed before reset() or the destructor
+    class arena {
+        public:
+            arena() : head_(nullptr), cur_(nullptr), end_(nullptr) {}
+            ~arena() { release(); }
+            arena(const arena&) = delete;
+            arena& operator=(const arena&) = delete;
+            void* allocate(size_t size) {
+                size = (size + 15) & ~size_t(15);
+                if (size > size_t(end_ - cur_)) {
+                    grow(size);
+                }
+                void* p = cur_;
+                cur_ += size;
+                return p;
+            }
+            // one copy of every string, for the keys repeated across a document
+            const char* intern(const char* s, size_t len) {
+                if ((pooled_ + 1) * 2 > pool_.size()) {
+                    growPool();
+                }
+                size_t hash = hashOf(s, len);
+                size_t mask = pool_.size() - 1;
+                for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+                    pooled& slot = pool_[i];
+                    if (slot.data == nullptr) {
+                        char* copy = (char*)allocate(len + 1);
+                        memcpy(copy, s, len);
+                        copy[len] = '\0';
+                        slot.data = copy;
+                        slot.size = len;
+                        slot.hash = hash;
+                        ++ pooled_;
+                        return copy;
+                    }
+                    if (slot.hash == hash && slot.size == len && memcmp(slot.data, s, len) == 0) {
+                        return slot.data;
+                    }
+                }
+            }
+            // frees everything but the last block, which is reused
+            void reset() {
+                if (head_ == nullptr) {
+                    return;
+                }
+                block* keep = head_;
+                head_ = head_->next;
+                release();
+                keep->next = nullptr;
+                head_ = keep;
+                cur_ = (char*)(keep + 1);
+                end_ = cur_ + keep->size;
+            }
+        private:
+            struct alignas(16) block {
+                block* next;
+                size_t size;
+            };
+            void grow(size_t size) {
+                // blocks double from 64 KB up to 64 MB, larger requests get their own
+                size_t last = head_ == nullptr ? 0 : head_->size;
+                size_t blockSize = std::max(size, std::min(std::max(last * 2, size_t(64) << 10), size_t(64) << 20));
+                block* b = (block*)::operator new(sizeof(block) + blockSize);
+                b->next = head_;
+                b->size = blockSize;
+                head_ = b;
+                cur_ = (char*)(b + 1);
+                end_ = cur_ + blockSize;
+            }
+            void release() {
+                while (head_ != nullptr) {
+                    block* next = head_->next;
+                    ::operator delete(head_);
+                    head_ = next;
+                }
+                cur_ = end_ = nullptr;
+                pool_.clear();
+                pooled_ = 0;
+            }
+            // open addressing, at most half full
+            struct pooled {
+                const char* data;
+                size_t size;
+                size_t hash;
+            };
+            static size_t hashOf(const char* s, size_t len) { // FNV-1a
+                uint64_t hash = 14695981039346656037ull;
+                for (size_t i = 0; i < len; ++ i) {
+                    hash = (hash ^ (unsigned char)s[i]) * 1099511628211ull;
+                }
+                return (size_t)hash;
+            }
+            void growPool() {
+                std::vector<pooled> old(std::max(pool_.size() * 2, size_t(64)), pooled{nullptr, 0, 0});
+                old.swap(pool_);
+                size_t mask = pool_.size() - 1;
+                for (const pooled& slot : old) {
+                    if (slot.data != nullptr) {
+                        size_t i = slot.hash & mask;
+                        while (pool_[i].data != nullptr) {
+                            i = (i + 1) & mask;
+                        }
+                        pool_[i] = slot;
+                    }
+                }
+            }
+            block* head_;
+            char* cur_;
+            char* end_;
+            std::vector<pooled> pool_;
+            size_t pooled_ = 0;
+    };
+
+    class json;
+    // how the containers of a document build their elements; json nodes and members are
+    // relocated exactly by the specializations below json, anything else is built as usual
+    template<typename T>
+    struct arenaConstruct {
+        template<typename... Args>
+        static void construct(T* p, Args&&... args) {
+            ::new((void*)p) T(std::forward<Args>(args)...);
+        }
+    };
+
+    // allocates from an arena, or from the heap when there is none
+    template<typename T>
+    class arenaAllocator {
+        public:
+            typedef T value_type;
+            arenaAllocator(arena* a = nullptr) noexcept : arena_(a) {}
+            template<typename U>
+            arenaAllocator(const arenaAllocator<U>& other) noexcept : arena_(other.arena_) {}
+            T* allocate(size_t n) {
+                if (arena_ == nullptr) {
+                    return (T*)::operator new(n * sizeof(T));
+                }
+                return (T*)arena_->allocate(n * sizeof(T));
+            }
+            void deallocate(T* p, size_t /*n*/) noexcept {
+                if (arena_ == nullptr) {
+                    ::operator delete(p);
+                }
+            }
+            template<typename U, typename... Args>
+            void construct(U* p, Args&&... args) {
+                arenaConstruct<U>::construct(p, std::forward<Args>(args)...);
+            }
+            template<typename U>
+            bool operator==(const arenaAllocator<U>& rhs) const { return arena_ == rhs.arena_; }
+            template<typename U>
+            bool operator!=(const arenaAllocator<U>& rhs) const { return arena_ != rhs.arena_; }
+            arena* arena_;
+    };
+
     class json {
 
 
         public: // enums
-            enum jsonType { 
+            enum jsonType : unsigned char { 
                 JSON_NULL, 
                 JSON_FALSE, 
                 JSON_TRUE, 
@@ -43,70 +258,620 @@ namespace xushun {
                 JSON_PARSE_MISS_COMMA_OR_SQUARE_BRACKET,// 逗号或方括号丢失
                 JSON_PARSE_MISS_KEY,                    // json对象成员的key丢失
                 JSON_PARSE_MISS_COLON,                  // 冒号丢失
-                JSON_PARSE_MISS_COMMA_OR_CURLY_BRACKET  // 逗号或大括号丢失
+                JSON_PARSE_MISS_COMMA_OR_CURLY_BRACKET, // 逗号或大括号丢失
+                JSON_PARSE_TERMINATED,                  // handler返回false, 解析被中止
+                JSON_PARSE_FILE_ERROR,                  // 文件无法打开或读取
+                JSON_PARSE_BINARY_TRUNCATED,            // 二进制输入在值的中间结束
+                JSON_PARSE_DEPTH_EXCEEDED               // 嵌套层数超过getMaxDepth()
             };
 
 
 
 
-        private: // dumper
-            std::string dumpedString_;
-
-            void dumpValue(std::string& dumpedString);
-            void dumpString(std::string& dumpedString, const std::string& s);
+        public: // dumper
+            class writer;
+        private:
+            // open containers and the index of their next child
+            typedef std::vector<std::pair<json*, size_t>> dumpStack;
+            // with a writer, dumpedString is its block and goes out whenever it fills
+            void dumpValue(std::string& dumpedString, writer* w = nullptr, dumpStack* reuse = nullptr);
+            void dumpLeaf(std::string& dumpedString, writer* w = nullptr); // a scalar or an empty container
+            void dumpString(std::string& dumpedString, const char* s, size_t len, writer* w = nullptr);
+            // the children [begin, end) of this container, each after its comma
+            void dumpChildren(std::string& dumpedString, size_t begin, size_t end, writer* w, dumpStack* reuse);
+            enum : size_t { PARALLEL_SLICE = 1024 * 1024 };
+            void dumpParallel(std::string& dumpedString, writer* w, unsigned threads);
         public:
             std::string dump();
+            // the largest container, found down the path of the most children, is cut into slices
+            // dumped by threads (0 for one per core) and joined in order; the text is that of dump()
+            std::string dumpParallel(unsigned threads = 0);
+            // output in blocks of 64KB, so a tree is written in bounded memory whatever its size;
+            // once the sink fails or a fixed buffer is full, the rest is dropped and good() is false
+            class writer {
+                public:
+                    typedef std::function<bool(const char* data, size_t len)> callback; // false on failure
+                    explicit writer(std::ostream& out);
+                    explicit writer(FILE* file);
+                    explicit writer(int fd);
+                    writer(char* buffer, size_t size);  // size() tells how much of the buffer is used
+                    explicit writer(const callback& sink);
+                    ~writer();                          // flushes
+                    writer(const writer&) = delete;
+                    writer& operator=(const writer&) = delete;
+                    bool write(json& value);
+                    // dumpParallel() in rounds of slices of about 1MB per thread, handed to the sink in order
+                    bool write(json& value, unsigned threads);
+                    bool write(const char* data, size_t len);   // raw text, a separator or a newline
+                    bool flush();
+                    bool good();
+                    size_t size();                      // bytes the sink has taken so far
+                private:
+                    friend class json;
+                    enum : size_t { BLOCK = 65536 };
+                    void init();
+                    void drain();
+                    void put(const char* data, size_t len);
+                    std::string block_;
+                    dumpStack stack_;
+                    callback sink_;
+                    size_t size_;
+                    bool good_;
+            };
 
 
 
 
         private: // parser
-            class parseContext {
+            class parseContext; // see below the value storage
+
+            static void parseWhitespace(parseContext& context);
+            static jsonError parseLiteralRaw(parseContext& context, const char* literal);
+            static jsonError parseNumberRaw(parseContext& context, double& num);
+            static bool parseHex4(parseContext& context, unsigned& u);
+            static void encodeUtf8(parseContext& context, unsigned u);
+            // str points into the input, or into the stack when escapes were decoded
+            static jsonError parseStringRaw(parseContext& context, stringView& str);
+            static jsonError parseStringRaw(parseContext& context, std::string& dst);
+            // the containers open so far are kept on a stack of their own, never on the C++ stack;
+            // with Indexed, the tape from indexStructure() skips the whitespace
+            struct eventSink;
+            struct treeSink;
+            template<bool Indexed, typename Sink>
+            static jsonError walkValue(parseContext& context, Sink& sink, const std::vector<uint32_t>* tape);
+            jsonError parseValue(parseContext& context); // this must be null
+            jsonError parseRoot(parseContext& context);  // the whole input, null on an error
+            static std::atomic<size_t>& maxDepth();
+        public:
+            // containers nested deeper than this are JSON_PARSE_DEPTH_EXCEEDED, for every parser
+            // and every thread; 1000 by default
+            static void setMaxDepth(size_t depth);
+            static size_t getMaxDepth();
+            jsonError parse(const std::string& jsonString);
+            jsonError parse(const char* jsonString);
+            jsonError parse(const char* data, size_t len);
+            jsonError parse(const stringView& jsonString);
+
+
+
+
+        public: // sax
+            // parse events, every callback returns false to stop the parse
+            class handler {
+                public:
+                    virtual ~handler() {}
+                    virtual bool null() { return true; }
+                    virtual bool boolean(bool /*b*/) { return true; }
+                    virtual bool number(double /*num*/) { return true; }
+                    virtual bool string(const stringView& /*str*/) { return true; } // valid during the call only
+                    virtual bool startObject() { return true; }
+                    virtual bool key(const stringView& /*key*/) { return true; }    // valid during the call only
+                    virtual bool endObject(size_t /*memberCount*/) { return true; }
+                    virtual bool startArray() { return true; }
+                    virtual bool endArray(size_t /*elementCount*/) { return true; }
+            };
+        private:
+            static jsonError parseEventString(parseContext& context, handler& h, bool isKey);
+            static jsonError parseEventValue(parseContext& context, handler& h);
+            static jsonError parseEventRoot(parseContext& context, handler& h);
+        public:
+            // no tree is built, events are reported as they are parsed
+            static jsonError parse(const char* data, size_t len, handler& h);
+            static jsonError parse(const stringView& jsonString, handler& h);
+
+
+
+
+        public: // structural index
+            // the grammar and errors of parse() in two passes: SIMD finds the position of
+            // every token and every clean string, then the tokens are walked without recursion;
+            // the index is a pass of its own, bench_16_indexed weighs it against parse()
+            jsonError parseIndexed(const std::string& jsonString);
+            jsonError parseIndexed(const char* jsonString);
+            jsonError parseIndexed(const char* data, size_t len);
+            jsonError parseIndexed(const stringView& jsonString);
+            static jsonError parseIndexed(const char* data, size_t len, handler& h);
+            static const char* indexEngine(); // "avx2", "sse2" or "scalar", chosen by CPU feature
+
+
+
+
+        private: // stream
+            // builds a tree from parse events
+            class builder : public handler {
+                public:
+                    explicit builder(json* root) : root_(root) {}
+                    void reset();
+                    bool null() override;
+                    bool boolean(bool b) override;
+                    bool number(double num) override;
+                    bool string(const stringView& str) override;
+                    bool startObject() override;
+                    bool key(const stringView& key) override;
+                    bool endObject(size_t memberCount) override;
+                    bool startArray() override;
+                    bool endArray(size_t elementCount) override;
                 private:
-                    std::string unparsed_;
-                    int idx_;
-                    std::string stack_;
+                    json& place(); // slot of the next value
+                    json* root_;
+                    std::vector<json*> stack_; // open containers
+                    std::string key_;
+            };
+        public:
+            // resumable parser, the input is fed a chunk at a time and
+            // tokens may be split anywhere across chunks
+            class streamParser {
                 public:
-                    parseContext(const std::string& jsonString);
-                    int idx();
-                    void resetIdx(int idx);
-                    char cur();
-                    char curPass();
-                    std::string subUnparsed(int startIdx, int len);
-                    void stackPushCh(char ch);
-                    void stackPushStr(std::string str);
-                    std::string stackPop(int len);
-                    int stackSize();
+                    explicit streamParser(handler& h);
+                    explicit streamParser(json& result); // builds a tree into result
+                    streamParser(const streamParser&) = delete;
+                    streamParser& operator=(const streamParser&) = delete;
+                    // OK while the input seen so far is a valid prefix
+                    jsonError feed(const char* data, size_t len);
+                    jsonError feed(const stringView& chunk);
+                    // end of input, returns the result of the whole parse
+                    jsonError finish();
+                    // ready for the next document
+                    void reset();
+                private:
+                    enum parseState { VALUE, ARRAY_FIRST, OBJECT_FIRST, KEY, COLON, AFTER_VALUE, AFTER_ROOT };
+                    struct frame {
+                        bool isObject;
+                        size_t count;
+                    };
+                    static size_t scanString(const char* p, size_t len, bool& escape);
+                    static size_t scanRun(const char* p, size_t len);
+                    bool tokenComplete(parseContext& context);
+                    jsonError run(const char* data, size_t len, size_t& used);
+                    jsonError closeContainer();
+                    void valueDone();
+                    jsonError fail(jsonError err);
+                    builder builder_;
+                    handler* handler_;
+                    json* result_;
+                    parseState state_;
+                    std::vector<frame> stack_;
+                    std::string carry_;   // the token cut at the end of the last chunk
+                    bool carryString_;
+                    bool escape_;         // the carried string ends inside an escape
+                    bool finished_;
+                    jsonError error_;
             };
 
-            void parseWhitespace(parseContext& context);
-            jsonError parseLiteral(parseContext& context, std::string&& literal, jsonType type);
-            jsonError parseNumber(parseContext& context);
-            bool parseHex4(parseContext& context, unsigned& u);
-            void encodeUtf8(parseContext& context, unsigned u);
-            jsonError parseStringRaw(parseContext& context, std::string& dst);
-            jsonError parseString(parseContext& context);
-            jsonError parseArray(parseContext& context);
-            jsonError parseObject(parseContext& context);
-            jsonError parseValue(parseContext& context);
+
+
+
+        private: // file
+            // read-only view of a whole file, mapped where mmap is available
+            class mappedFile {
+                public:
+                    mappedFile() : data_(nullptr), size_(0), mapped_(false) {}
+                    ~mappedFile() { close(); }
+                    mappedFile(const mappedFile&) = delete;
+                    mappedFile& operator=(const mappedFile&) = delete;
+                    bool open(const std::string& path);
+                    void close();
+                    const char* data() { return data_; }
+                    size_t size() { return size_; }
+                private:
+                    const char* data_;
+                    size_t size_;
+                    bool mapped_;
+                    std::string buffer_; // read into memory otherwise
+            };
         public:
-            jsonError parse(const std::string& jsonString);
+            // strings and numbers are decoded straight from the mapped pages
+            jsonError parseFile(const std::string& path);
+
+
+
+
+        public: // json lines
+            // one value per line, blank lines are skipped
+            class lineReader {
+                public:
+                    lineReader();
+                    lineReader(const char* data, size_t len); // the buffer must outlive the reader
+                    explicit lineReader(const stringView& buffer);
+                    bool open(const std::string& path);       // maps the whole file, false if it can not
+                    // false at the end of input or on an error
+                    bool next(json& record);
+                    jsonError error();
+                    size_t line();                            // line of the last record or of the error
+                private:
+                    mappedFile file_;
+                    const char* data_;
+                    size_t len_, pos_, line_;
+                    jsonError error_;
+            };
+            class lineWriter {
+                public:
+                    explicit lineWriter(std::string& out);
+                    explicit lineWriter(FILE* file);
+                    ~lineWriter();
+                    lineWriter(const lineWriter&) = delete;
+                    lineWriter& operator=(const lineWriter&) = delete;
+                    void write(json& record);
+                    void flush();
+                private:
+                    std::string buffer_;
+                    std::string* out_;
+                    FILE* file_;
+            };
+        private:
+            static jsonError parseLinesRaw(const char* data, size_t len, std::vector<json>& records, size_t& lines);
+        public:
+            // the input is split at newlines and parsed by threads (0 for one per core),
+            // records keep their order, on an error records holds the ones before errorLine
+            static jsonError parseLines(const char* data, size_t len, std::vector<json>& records, size_t& errorLine, unsigned threads = 0);
+            static jsonError parseLines(const stringView& buffer, std::vector<json>& records, size_t& errorLine, unsigned threads = 0);
+        private:
+            enum : size_t { PARALLEL_PART_MIN = 256 * 1024 };
+            jsonError parseElements(const char* data, size_t len, std::vector<json>& elements);
+        public:
+            // a top-level array is cut between its elements into parts parsed by threads (0 for one
+            // per core) and joined in order; any other value, a small input or an arena document
+            // goes through parse(), as does an input with an error, so the error is that of parse()
+            jsonError parseParallel(const char* data, size_t len, unsigned threads = 0);
+            jsonError parseParallel(const stringView& text, unsigned threads = 0);
+
+
+
+
+        public: // json pointer
+            // an RFC 6901 pointer compiled once: "/a/0/b~1c" is split into its reference tokens,
+            // unescaped, and a token that reads as an array index keeps it as a number;
+            // "" is the whole document, any other text must start with '/'
+            class pointer {
+                public:
+                    pointer();
+                    explicit pointer(const std::string& text);
+                    explicit pointer(const char* text);
+                    bool valid();       // false for text that is not a pointer, which then finds nothing
+                    size_t size();      // the number of reference tokens
+                private:
+                    friend class json;
+                    struct step {
+                        std::string key;
+                        size_t index;   // npos unless the token is an array index
+                    };
+                    void compile(const char* text, size_t len);
+                    std::vector<step> steps_;
+                    bool valid_;
+            };
+            // the value the pointer refers to, nullptr if there is none; nothing is allocated or inserted
+            json* find(const pointer& at);
+        private:
+            struct pointerSink;
+        public:
+            // only the events of the value the pointer refers to reach h, none if there is no such value;
+            // the parse stops after that value, or as soon as the path is passed
+            static jsonError parse(const char* data, size_t len, const pointer& at, handler& h);
+            static jsonError parse(const stringView& jsonString, const pointer& at, handler& h);
+
+
+
+
+        public: // on demand
+            // a value read in place from a buffer that must outlive it and every value taken from it;
+            // parse() checks the text with the grammar of parse() but builds nothing,
+            // lookups skip what they pass over and only the values read are decoded
+            class lazyValue {
+                public:
+                    lazyValue();
+                    jsonError parse(const char* data, size_t len);
+                    jsonError parse(const stringView& buffer);
+                    jsonError error();  // of the parse this value comes from
+                    bool exists();      // false for a missing member or element, or after an error
+                    jsonType getType(); // JSON_NULL if it does not exist
+                    bool getBoolean();
+                    double getNumber();
+                    std::string getString();
+                    size_t getArraySize();
+                    size_t getObjectSize();
+                    bool existObjectElement(const std::string& key);
+                    lazyValue operator[](size_t index);
+                    lazyValue operator[](const std::string& key);
+                    template<typename T>
+                    lazyValue operator[](T* key);
+                    lazyValue find(const pointer& at);  // one step of operator[] per token
+                    stringView raw();   // the text of the value
+                    jsonError get(json& out); // builds this value
+                private:
+                    lazyValue(const char* data, size_t len, size_t pos);
+                    lazyValue member(const char* key, size_t len);
+                    size_t next(size_t pos, char close); // past the ',' after a value, npos at close
+                    const char* data_;
+                    size_t len_;
+                    size_t pos_;        // first char of the value, npos if it does not exist
+                    jsonError error_;
+            };
+        private:
+            static size_t skipValidString(const char* data, size_t len, size_t pos);
+            static size_t skipValidValue(const char* data, size_t len, size_t pos);
+            static size_t skipValidWhitespace(const char* data, size_t len, size_t pos);
+
+
+
+
+        private: // binary
+            void dumpCborValue(std::string& out);
+            void dumpCborNode(std::string& out); // a scalar, or the head of an array or object
+            static void dumpCborHead(std::string& out, unsigned char major, uint64_t n);
+            static jsonError parseCborHead(parseContext& context, unsigned char& major, unsigned char& info, uint64_t& n);
+            template<typename Sink>
+            static jsonError parseCborValue(parseContext& context, Sink& sink);
+        public:
+            // CBOR (RFC 8949): doubles as their 8 IEEE bytes, whole numbers up to 2^53 as integers,
+            // strings, arrays and objects with their length in front
+            std::string dumpCbor();
+            void dumpCbor(std::string& out); // appends
+            // half, single and double floats and integers are read as numbers,
+            // tags, byte strings, undefined and indefinite lengths are JSON_PARSE_INVALID_VALUE
+            jsonError parseCbor(const char* data, size_t len);
+            jsonError parseCbor(const stringView& buffer);
+            // no tree is built, strings and keys are views into data, nothing is copied
+            static jsonError parseCbor(const char* data, size_t len, handler& h);
 
 
 
 
         private: // json value
+            typedef std::basic_string<char, std::char_traits<char>, arenaAllocator<char>> stringType;
+            typedef std::vector<json, arenaAllocator<json>> arrayType;
+            // an object key in 16 bytes: up to 15 chars inline, longer keys point at
+            // a heap copy they own, or into the intern pool of an arena document
+            class keyType {
+                public:
+                    keyType() { setEmpty(); }
+                    keyType(const char* s, size_t len, arena* a) {
+                        if (len <= 15) {
+                            memset(raw_, 0, sizeof(raw_));
+                            memcpy(raw_, s, len);
+                            raw_[15] = (char)(15 - len); // 0 ends a 15 char key
+                            return;
+                        }
+                        const char* p;
+                        if (a != nullptr) {
+                            p = a->intern(s, len);
+                            raw_[15] = POOLED;
+                        } else {
+                            char* copy = new char[len + 1];
+                            memcpy(copy, s, len);
+                            copy[len] = '\0';
+                            p = copy;
+                            raw_[15] = OWNED;
+                        }
+                        memcpy(raw_, &p, sizeof(p));
+                        for (int i = 0; i < 7; ++ i) {
+                            raw_[8 + i] = (char)(len >> (8 * i));
+                        }
+                    }
+                    // a copy needs to know its storage, see copyValue()
+                    keyType(const keyType&) = delete;
+                    keyType& operator=(const keyType&) = delete;
+                    keyType(keyType&& src) noexcept {
+                        memcpy(raw_, src.raw_, sizeof(raw_));
+                        src.setEmpty();
+                    }
+                    keyType& operator=(keyType&& src) noexcept {
+                        if (this != &src) {
+                            freeKey();
+                            memcpy(raw_, src.raw_, sizeof(raw_));
+                            src.setEmpty();
+                        }
+                        return *this;
+                    }
+                    ~keyType() { freeKey(); }
+                    const char* data() const {
+                        if (isInline()) {
+                            return raw_;
+                        }
+                        const char* p;
+                        memcpy(&p, raw_, sizeof(p));
+                        return p;
+                    }
+                    size_t size() const {
+                        if (isInline()) {
+                            return 15 - raw_[15];
+                        }
+                        size_t len = 0;
+                        for (int i = 0; i < 7; ++ i) {
+                            len |= (size_t)(unsigned char)raw_[8 + i] << (8 * i);
+                        }
+                        return len;
+                    }
+                    // short keys and pooled keys of one document compare as 16 bytes
+                    bool operator==(const keyType& rhs) const {
+                        if (memcmp(raw_, rhs.raw_, sizeof(raw_)) == 0) {
+                            return true;
+                        }
+                        if (isInline() || rhs.isInline()) {
+                            return false;
+                        }
+                        size_t len = size();
+                        return len == rhs.size() && memcmp(data(), rhs.data(), len) == 0;
+                    }
+                    bool operator<(const keyType& rhs) const {
+                        size_t lenA = size(), lenB = rhs.size();
+                        int cmp = memcmp(data(), rhs.data(), std::min(lenA, lenB));
+                        return cmp < 0 || (cmp == 0 && lenA < lenB);
+                    }
+                private:
+                    enum : char { POOLED = 16, OWNED = 17 };
+                    bool isInline() const { return raw_[15] < POOLED; }
+                    void setEmpty() {
+                        memset(raw_, 0, sizeof(raw_));
+                        raw_[15] = 15;
+                    }
+                    void freeKey() {
+                        if (raw_[15] == OWNED) {
+                            delete[] data();
+                        }
+                    }
+                    alignas(8) char raw_[16];
+            };
+            // members sorted by key, or in insertion order when keepOrder_ is set
+            typedef std::pair<keyType, json> memberType;
+            typedef std::vector<memberType, arenaAllocator<memberType>> objectType;
+            // only the member selected by type_ is alive,
+            // containers and strings longer than 8 chars are stored out of line
+            union {
+                objectType* object_;                  // JSON_OBJECT
+                arrayType* array_;                    // JSON_ARRAY
+                stringType* string_;                  // JSON_STRING, LONG_STRING
+                char short_[8];                       // JSON_STRING, up to 8 chars
+                double number_;                       // JSON_NUMBER
+            };
             jsonType type_;
-            
-            std::map<std::string, json> object_; // JSON_OBJECT
-            std::vector<json> array_;  // JSON_ARRAY
-            std::string string_;       // JSON_STRING
-            double number_;            // JSON_NUMBER
+            bool ownsArena_ = false;                  // root of an arena document
+            bool keepOrder_ = false;                  // objects keep insertion order, inherited by new children
+            unsigned char shortSize_ = 0;             // length of short_, or LONG_STRING
+            uint32_t arena_ = 0;                      // id of the arena holding the storage, 0 for the heap
+            enum : unsigned char { SHORT_STRING_MAX = 8, LONG_STRING = 0xFF };
+
+            void copyValue(const json& src);
+            typedef std::vector<std::pair<json*, const json*>> copyList;
+            void copyBelow(const json& src, size_t depth, copyList& deeper);
+            void takeValue(json& src);
+            void freeValue();
+            void freeContainer(); // a heap array or object
+            void deleteContainer();
+            enum : size_t { FREE_DEPTH = 64 };
+            bool hasChildren() const {
+                return (type_ == JSON_ARRAY && !array_->empty()) || (type_ == JSON_OBJECT && !object_->empty());
+            }
+            // storage is allocated from the arena of this node
+            struct arenaTable;
+            static arenaTable& arenas();
+            static uint32_t arenaAttach(arena* a);
+            static void arenaDetach(uint32_t id);
+            static arena* arenaOf(uint32_t id);
+            arenaAllocator<char> allocator();
+            template<typename T, typename... Args>
+            T* create(Args&&... args);
+            json& inherit(json& child);               // child becomes part of this value
+            size_t objectIndex(const char* key, size_t len); // npos if missing
+            json* objectFind(const char* key, size_t len);
+            json& objectSlot(const char* key, size_t len);
+            json& objectAppend(const char* key, size_t len); // no lookup, objectFinish() drops repeated keys
+            void objectFinish();
+            void setStringRaw(const char* s, size_t len);
+            void initString(const char* s, size_t len); // this must be null
+            stringView stringValue() const;
+        public:
+            class parser;
+        private:
+            class parseContext {
+                private:
+                    const char* unparsed_; // caller's buffer, never copied
+                    size_t len_;
+                    size_t idx_;
+                    std::string stack_;
+                    // elements of the open containers, moved into one exact allocation on close;
+                    // the allocator relocates the arena nodes among them as the containers do
+                    arrayType elements_;
+                    objectType members_;
+                    std::vector<size_t> levels_, bases_;
+                    parser* reuse_; // lends its buffers for the parse, they go back emptied
+                    size_t outer_;  // containers open around the input, against getMaxDepth()
+                public:
+                    parseContext(const char* data, size_t len, parser* reuse = nullptr);
+                    ~parseContext();
+                    parseContext(const parseContext&) = delete;
+                    parseContext& operator=(const parseContext&) = delete;
+                    size_t idx();
+                    void resetIdx(size_t idx);
+                    bool end();
+                    char cur();     // '\0' past the end
+                    char curPass(); // never moves past the end
+                    const char* curPtr();
+                    size_t left();
+                    void pass(size_t n);
+                    std::string subUnparsed(size_t startIdx, size_t len);
+                    void stackPushCh(char ch);
+                    void stackPushStr(std::string str);
+                    void stackPushStr(const char* str, size_t len);
+                    std::string stackPop(size_t len);
+                    size_t stackSize();
+                    const char* stackAt(size_t idx);
+                    void stackResize(size_t size);
+                    arrayType& elements();
+                    objectType& members();
+                    std::vector<size_t>& levels();  // containers open in walkValue()
+                    std::vector<size_t>& bases();   // of the containers open in treeSink
+                    size_t& outer();
+            };
+        public: // reusable contexts
+            // the scratch buffers of parse() kept from one call to the next, so a steady loop
+            // allocates nothing but the trees; for one thread at a time
+            class parser {
+                public:
+                    jsonError parse(json& value, const char* data, size_t len);
+                    jsonError parse(json& value, const stringView& text);
+                    jsonError parse(const char* data, size_t len, handler& h);
+                private:
+                    friend class json;
+                    std::string stack_;
+                    arrayType elements_;
+                    objectType members_;
+                    std::vector<size_t> levels_, bases_;
+            };
+            // dump() into an output kept from one call to the next; for one thread at a time
+            class serializer {
+                public:
+                    const std::string& dump(json& value); // valid until the next call
+                private:
+                    std::string out_;
+                    dumpStack stack_;
+            };
+        public:
+            // this value, and everything parsed or inserted under it, is allocated from
+            // an arena owned by this node and released at once;
+            // a node moved out of the document is copied to the heap on the way;
+            // at most 2^20 arena documents live at a time, past that the value stays on the heap
+            // and false is returned, as it is for a value that is not in an arena of its own
+            bool setArena();
+            bool isArena(); // in an arena document, as its root or below it
         public:
             // constructor and operator=
             json();
+            ~json();
             json(const json& src);
+            // a node inside an arena document is copied to the heap, so that it may outlive the document;
+            // that child keeps its value, unlike a moved heap node which is left null, and running
+            // out of memory during the copy calls std::terminate (noexcept, for std::vector<json>)
+            json(json&& src) noexcept;
+        private:
+            // an exact move that keeps the arena, for the containers of the same document
+            struct relocateTag {};
+            static relocateTag relocate() { return relocateTag(); }
+            template<typename T>
+            friend struct arenaConstruct;
+        public:
+            json(json&& src, relocateTag) noexcept;
             json(const std::string& str);
+            json(std::string&& str);
             json(const char* str);
             json(double num);
             json(bool b);
@@ -115,7 +880,9 @@ namespace xushun {
             template<typename T>
             json(const std::map<std::string,T>& mp);
             json& operator=(const json& src);
+            json& operator=(json&& src) noexcept;
             json& operator=(const std::string& str);
+            json& operator=(std::string&& str);
             json& operator=(const char* str);
             json& operator=(double num);
             json& operator=(bool b);
@@ -125,6 +892,11 @@ namespace xushun {
             json& operator=(const std::map<std::string,T>& mp);
             // equal and operator==
             bool isEqual(const json& rhs);
+        private:
+            // recursion up to a fixed depth, the pairs of containers below wait on a list
+            typedef std::vector<std::pair<const json*, const json*>> pairList;
+            static bool isEqualBelow(const json& lhs, const json& rhs, size_t depth, pairList& deeper);
+        public:
             bool isEqual(const std::string& str);
             bool isEqual(const char* str);
             bool isEqual(double num);
@@ -156,29 +928,68 @@ namespace xushun {
             double getNumber();
             void setNumber(double n);
             // string
-            std::string getString();
+            std::string getString(); // up to the first '\0'
+            // the whole string without a copy, valid until this value is changed or moved
+            stringView getStringView();
+            size_t getStringLength();
             void setString(const std::string& s);
+            void setString(std::string&& s);
             // array
             void setArray();
-            int getArraySize();
+            size_t getArraySize();
             void clearArray();
-            json& getArrayElement(int index);
-            void pushbackArray(const json j);
+            json& getArrayElement(size_t index);
+            void pushbackArray(const json& j);
+            void pushbackArray(json&& j);
+            json& emplacebackArray(); // append a null element and return it
             void popbackArray();
-            void insertArrayElement(int index, json j);
-            void eraseArrayElement(int index, int count);
-            json& operator[](int index); // []fetch
+            void insertArrayElement(size_t index, const json& j);
+            void insertArrayElement(size_t index, json&& j);
+            void eraseArrayElement(size_t index, size_t count);
+            json& operator[](size_t index); // []fetch
             // object
             void setObject();
-            int getObjectSize();
+            size_t getObjectSize();
             void clearObject();
             bool existObjectElement(const std::string& key);
             json& findObjectElement(const std::string& key);
             void eraseObjectElement(const std::string& key);
-            void insertObjectElement(const std::string& key, const json j);
+            void insertObjectElement(const std::string& key, const json& j);
+            void insertObjectElement(const std::string& key, json&& j);
+            void insertObjectElement(std::string&& key, json&& j);
+            json& emplaceObjectElement(std::string&& key); // find or insert a null member
+            // members in dump() order, sorted by key unless the insertion order is kept
+            stringView getObjectKey(size_t index);
+            json& getObjectValue(size_t index);
+            // objects created in this value from now on keep their members in insertion order
+            void setKeepOrder(bool keep);
             json& operator[](const std::string& key); // []fetch
-            json& operator[](const char* key);
+            template<typename T>
+            json& operator[](T* key); // const char*, a template so that j[0] picks the index
+
+    };
 
+    // a node or a member moved from one slot of a document into another keeps its arena
+    template<>
+    struct arenaConstruct<json> {
+        static void construct(json* p, json&& src) {
+            ::new((void*)p) json(std::move(src), json::relocate());
+        }
+        template<typename... Args>
+        static void construct(json* p, Args&&... args) {
+            ::new((void*)p) json(std::forward<Args>(args)...);
+        }
+    };
+    template<typename K>
+    struct arenaConstruct<std::pair<K, json>> {
+        static void construct(std::pair<K, json>* p, std::pair<K, json>&& src) {
+            ::new((void*)p) std::pair<K, json>(std::piecewise_construct,
+                std::forward_as_tuple(std::move(src.first)), std::forward_as_tuple(std::move(src.second), json::relocate()));
+        }
+        template<typename... Args>
+        static void construct(std::pair<K, json>* p, Args&&... args) {
+            ::new((void*)p) std::pair<K, json>(std::forward<Args>(args)...);
+        }
     };
 
 
@@ -208,27 +1019,64 @@ namespace xushun {
     json::json() {
         type_ = JSON_NULL;
     }
+    json::~json() {
+        if (ownsArena_) {
+            // the whole tree goes with the arena
+            arena* a = arenaOf(arena_);
+            arenaDetach(arena_);
+            delete a;
+            return;
+        }
+        freeValue();
+    }
     json::json(const json& src) {
+        type_ = JSON_NULL;
+        copyValue(src);
+    }
+    json::json(json&& src) noexcept {
+        if (src.arena_ != 0 && !src.ownsArena_) {
+            // the storage stays with the document, as in takeValue()
+            type_ = JSON_NULL;
+            keepOrder_ = src.keepOrder_;
+            copyValue(src);
+            return;
+        }
         type_ = src.type_;
-        switch (type_) {
-            case JSON_OBJECT:
-                object_ = src.object_; break;
-            case JSON_ARRAY:
-                array_ = src.array_; break;
-            case JSON_STRING:
-                string_ = src.string_; break;
-            case JSON_NUMBER:
-                number_ = src.number_; break;
-            default: break;
+        number_ = src.number_;
+        arena_ = src.arena_;
+        ownsArena_ = src.ownsArena_;
+        keepOrder_ = src.keepOrder_;
+        shortSize_ = src.shortSize_;
+        src.type_ = JSON_NULL;
+        if (src.ownsArena_) {
+            src.arena_ = 0;
+            src.ownsArena_ = false;
+        }
+    }
+    json::json(json&& src, relocateTag) noexcept {
+        type_ = src.type_;
+        number_ = src.number_;
+        arena_ = src.arena_;
+        ownsArena_ = src.ownsArena_;
+        keepOrder_ = src.keepOrder_;
+        shortSize_ = src.shortSize_;
+        src.type_ = JSON_NULL;
+        if (src.ownsArena_) {
+            src.arena_ = 0;
+            src.ownsArena_ = false;
         }
     }
     json::json(const std::string& str) {
-        type_ = JSON_STRING;
-        string_ = str;
+        type_ = JSON_NULL;
+        initString(str.data(), str.size());
+    }
+    json::json(std::string&& str) {
+        type_ = JSON_NULL;
+        initString(str.data(), str.size());
     }
     json::json(const char* str) {
-        type_ = JSON_STRING;
-        string_ = std::string(str);
+        type_ = JSON_NULL;
+        initString(str, strlen(str));
     }
     json::json(double num) {
         type_ = JSON_NUMBER;
@@ -239,6 +1087,7 @@ namespace xushun {
     }
     template<typename T>
     json::json(const std::vector<T>& vec) {
+        type_ = JSON_NULL;
         setArray();
         for (T t : vec) {
             pushbackArray(json(t));
@@ -246,6 +1095,7 @@ namespace xushun {
     }
     template<typename T>
     json::json(const std::map<std::string,T>& mp) {
+        type_ = JSON_NULL;
         setObject();
         for (auto itr = mp.begin(); itr != mp.end(); ++ itr) {
             insertObjectElement(itr->first, itr->second);
@@ -255,19 +1105,40 @@ namespace xushun {
         if (&src == this) {
             return * this;
         }
-        type_ = src.type_;
-        object_ = src.object_;
-        array_ = src.array_;
-        string_ = src.string_;
-        number_ = src.number_;
+        // src may live inside this value, copy it before releasing ours,
+        // the arena of a root is reset by freeValue so its copy goes to the heap
+        json tmp;
+        if (!ownsArena_) {
+            inherit(tmp);
+        }
+        tmp.copyValue(src);
+        freeValue();
+        takeValue(tmp);
+        return *this;
+    }
+    json& json::operator=(json&& src) noexcept {
+        if (&src == this) {
+            return * this;
+        }
+        if (arena_ != 0 && arena_ == src.arena_ && (ownsArena_ || src.ownsArena_)) {
+            // one is the root of the document holding the other
+            return *this = static_cast<const json&>(src);
+        }
+        json tmp(std::move(src), relocateTag());
+        freeValue();
+        takeValue(tmp);
         return *this;
     }
     json& json::operator=(const std::string& str) {
         setString(str);
         return *this;
     }
+    json& json::operator=(std::string&& str) {
+        setString(std::move(str));
+        return *this;
+    }
     json& json::operator=(const char* str) {
-        setString(std::string(str));
+        setStringRaw(str, strlen(str));
         return *this;
     }
     json& json::operator=(double num) {
@@ -298,93 +1169,937 @@ namespace xushun {
 
 
 
-    json::parseContext::parseContext(const std::string& jsonString) {
-        unparsed_ = jsonString;
-        idx_ = 0;
-    }
-    int json::parseContext::idx() {
-        return idx_;
-    }
-    void json::parseContext::resetIdx(int idx) {
-        idx_ = idx;
-    }
-    char json::parseContext::cur() {
-        return unparsed_[idx_];
-    }
-    char json::parseContext::curPass() {
-        return unparsed_[idx_ ++];
-    }
-    std::string json::parseContext::subUnparsed(int startIdx, int len) {
-        return unparsed_.substr(startIdx, len);
+    // string scanning
+    static inline int lowestBit(uint64_t x) { // x != 0
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(x);
+#else
+        int i = 0;
+        while ((x & 1) == 0) { x >>= 1; ++ i; }
+        return i;
+#endif
     }
-    void json::parseContext::stackPushCh(char ch) {
-        stack_ += ch;
-    }
-    void json::parseContext::stackPushStr(std::string str) {
-        stack_ += str;
-    }
-    std::string json::parseContext::stackPop(int len) {
-        std::string ret = stack_.substr(stack_.size() - len, len);
-        stack_.resize(stack_.size() - len);
-        return ret;
+    static inline int lowestBit32(uint32_t x) { // x != 0, a SIMD movemask
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctz(x);
+#elif defined(_MSC_VER)
+        unsigned long i;
+        _BitScanForward(&i, x);
+        return (int)i;
+#else
+        return lowestBit(x);
+#endif
     }
-    int json::parseContext::stackSize() {
-        return stack_.size();
+    // index of the first '\"', '\\' or control char in [p, p + len), len if none
+    static size_t findSpecialChar(const char* p, size_t len) {
+        size_t i = 0;
+#if defined(__AVX2__)
+        const __m256i quote = _mm256_set1_epi8('\"');
+        const __m256i slash = _mm256_set1_epi8('\\');
+        const __m256i ctrl = _mm256_set1_epi8(0x1f);
+        for (; i + 32 <= len; i += 32) {
+            __m256i x = _mm256_loadu_si256((const __m256i*)(p + i));
+            __m256i m = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(x, quote), _mm256_cmpeq_epi8(x, slash)),
+                _mm256_cmpeq_epi8(_mm256_max_epu8(x, ctrl), ctrl)); // x <= 0x1f
+            unsigned mask = (unsigned)_mm256_movemask_epi8(m);
+            if (mask != 0) { return i + lowestBit32(mask); }
+        }
+#elif defined(__SSE2__) || defined(_M_X64)
+        const __m128i quote = _mm_set1_epi8('\"');
+        const __m128i slash = _mm_set1_epi8('\\');
+        const __m128i ctrl = _mm_set1_epi8(0x1f);
+        for (; i + 16 <= len; i += 16) {
+            __m128i x = _mm_loadu_si128((const __m128i*)(p + i));
+            __m128i m = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(x, quote), _mm_cmpeq_epi8(x, slash)),
+                _mm_cmpeq_epi8(_mm_max_epu8(x, ctrl), ctrl)); // x <= 0x1f
+            unsigned mask = (unsigned)_mm_movemask_epi8(m);
+            if (mask != 0) { return i + lowestBit32(mask); }
+        }
+#else
+        // eight bytes at a time, a byte b is flagged by (b - 1) & ~b & 0x80 being set for b == 0
+        const uint64_t ones = 0x0101010101010101, highs = 0x8080808080808080;
+        for (; i + 8 <= len; i += 8) {
+            uint64_t x;
+            memcpy(&x, p + i, sizeof(x));
+            uint64_t q = x ^ (ones * '\"'), b = x ^ (ones * '\\');
+            uint64_t m = ((q - ones) & ~q) | ((b - ones) & ~b) | ((x - ones * 0x20) & ~x);
+            if (m & highs) { break; }
+        }
+#endif
+        while (i < len) {
+            unsigned char ch = p[i];
+            if (ch == '\"' || ch == '\\' || ch < 0x20) { break; }
+            ++ i;
+        }
+        return i;
     }
 
 
 
 
-
-
-
-
-    void json::parseWhitespace(parseContext& context) {
-        char ch = context.cur();
-        while (ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r') {
-            context.curPass();
-            ch = context.cur();
-        }
-    }
-    json::jsonError json::parseLiteral(parseContext& context, std::string&& literal, jsonType type) {
-        for (char ch : literal) {
-            if (ch != context.curPass()) {
-                return JSON_PARSE_INVALID_VALUE;
+    // structural index
+    // one 64 byte block as bit masks, bit i for byte i
+    struct blockMasks {
+        uint64_t quote, backslash, op, space; // op is one of {}[]:,
+        uint64_t control;                     // below 0x20, not allowed in strings
+    };
+    typedef void (*classifyBlock)(const char* p, blockMasks& m);
+    // set on a closing quote whose string has escapes or control chars to look at
+    enum : uint32_t { TAPE_DECODE = 0x80000000u, TAPE_POSITION = 0x7fffffffu };
+    static void classifyScalar(const char* p, blockMasks& m) {
+        m.quote = m.backslash = m.op = m.space = m.control = 0;
+        for (int i = 0; i < 64; ++ i) {
+            uint64_t bit = uint64_t(1) << i;
+            if ((unsigned char)p[i] < 0x20) { m.control |= bit; }
+            switch (p[i]) {
+                case '\"': m.quote |= bit; break;
+                case '\\': m.backslash |= bit; break;
+                case '{': case '}': case '[': case ']': case ':': case ',': m.op |= bit; break;
+                case ' ': case '\t': case '\n': case '\r': m.space |= bit; break;
+                default: break;
             }
         }
-        type_ = type;
-        return JSON_PARSE_OK;
     }
-    static bool isDigit(char ch) { return ch >= '0' && ch <= '9'; }
-    static bool isDigit1To9(char ch) { return ch >='1' && ch <= '9'; }
-    json::jsonError json::parseNumber(parseContext& context) {
-        int startIdx = context.idx();
-        if (context.cur() == '-') { context.curPass(); }
-        if (context.cur() == '0') { 
-            context.curPass();
-        } else {
-            if (!isDigit1To9(context.cur())) { return JSON_PARSE_INVALID_VALUE; }
-            while (isDigit(context.cur())) { context.curPass(); }
+#if (defined(__SSE2__) || defined(_M_X64)) && !defined(__AVX2__)
+    static void classifySse2(const char* p, blockMasks& m) {
+        m.quote = m.backslash = m.op = m.space = m.control = 0;
+        for (int k = 0; k < 4; ++ k) {
+            __m128i x = _mm_loadu_si128((const __m128i*)(p + 16 * k));
+            __m128i lower = _mm_or_si128(x, _mm_set1_epi8(0x20)); // '[' and ']' become '{' and '}'
+            __m128i op = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(lower, _mm_set1_epi8('{')), _mm_cmpeq_epi8(lower, _mm_set1_epi8('}'))),
+                _mm_or_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8(':')), _mm_cmpeq_epi8(x, _mm_set1_epi8(','))));
+            __m128i space = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(x, _mm_set1_epi8('\t'))),
+                _mm_or_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(x, _mm_set1_epi8('\r'))));
+            int shift = 16 * k;
+            m.quote |= (uint64_t)(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(x, _mm_set1_epi8('\"'))) << shift;
+            m.backslash |= (uint64_t)(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(x, _mm_set1_epi8('\\'))) << shift;
+            m.op |= (uint64_t)(unsigned)_mm_movemask_epi8(op) << shift;
+            m.space |= (uint64_t)(unsigned)_mm_movemask_epi8(space) << shift;
+            __m128i control = _mm_cmpeq_epi8(_mm_min_epu8(x, _mm_set1_epi8(0x1f)), x);
+            m.control |= (uint64_t)(unsigned)_mm_movemask_epi8(control) << shift;
         }
-        if (context.cur() == '.') {
-            context.curPass();
-            if (!isDigit(context.cur())) { return JSON_PARSE_INVALID_VALUE; }
-            while (isDigit(context.cur())) { context.curPass(); }
+    }
+#endif
+#if defined(__AVX2__) || ((defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__))
+#define JSON_INDEX_AVX2
+#if defined(__GNUC__) || defined(__clang__)
+    __attribute__((target("avx2")))
+#endif
+    static void classifyAvx2(const char* p, blockMasks& m) {
+        m.quote = m.backslash = m.op = m.space = m.control = 0;
+        for (int k = 0; k < 2; ++ k) {
+            __m256i x = _mm256_loadu_si256((const __m256i*)(p + 32 * k));
+            __m256i lower = _mm256_or_si256(x, _mm256_set1_epi8(0x20));
+            __m256i op = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(lower, _mm256_set1_epi8('{')), _mm256_cmpeq_epi8(lower, _mm256_set1_epi8('}'))),
+                _mm256_or_si256(_mm256_cmpeq_epi8(x, _mm256_set1_epi8(':')), _mm256_cmpeq_epi8(x, _mm256_set1_epi8(','))));
+            __m256i space = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(x, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(x, _mm256_set1_epi8('\t'))),
+                _mm256_or_si256(_mm256_cmpeq_epi8(x, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(x, _mm256_set1_epi8('\r'))));
+            int shift = 32 * k;
+            m.quote |= (uint64_t)(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, _mm256_set1_epi8('\"'))) << shift;
+            m.backslash |= (uint64_t)(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, _mm256_set1_epi8('\\'))) << shift;
+            m.op |= (uint64_t)(unsigned)_mm256_movemask_epi8(op) << shift;
+            m.space |= (uint64_t)(unsigned)_mm256_movemask_epi8(space) << shift;
+            __m256i control = _mm256_cmpeq_epi8(_mm256_min_epu8(x, _mm256_set1_epi8(0x1f)), x);
+            m.control |= (uint64_t)(unsigned)_mm256_movemask_epi8(control) << shift;
         }
-        if (context.cur() == 'e' || context.cur() == 'E') {
-            context.curPass();
-            if (context.cur() == '+' || context.cur() == '-') {
-                context.curPass();
+    }
+#endif
+    struct indexEngineEntry {
+        classifyBlock classify;
+        const char* name;
+    };
+    static const indexEngineEntry& selectIndexEngine() {
+        static const indexEngineEntry engine = []() {
+#if defined(__AVX2__)
+            return indexEngineEntry{classifyAvx2, "avx2"};
+#else
+#if defined(JSON_INDEX_AVX2)
+            if (__builtin_cpu_supports("avx2")) {
+                return indexEngineEntry{classifyAvx2, "avx2"};
             }
-            if (!isDigit(context.cur())) { return JSON_PARSE_INVALID_VALUE; }
-            while (isDigit(context.cur())) { context.curPass(); }
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+            return indexEngineEntry{classifySse2, "sse2"};
+#else
+            return indexEngineEntry{classifyScalar, "scalar"};
+#endif
+#endif
+        }();
+        return engine;
+    }
+    static inline int bitCount(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(x);
+#else
+        int n = 0;
+        for (; x != 0; x &= x - 1) { ++ n; }
+        return n;
+#endif
+    }
+    // the quotes that are not escaped, and the bytes of a block from an opening quote up to
+    // its closing quote, which is left out; the carries go from one block to the next
+    static inline uint64_t scanStrings(const blockMasks& m, uint64_t& escapedCarry, uint64_t& inStringCarry, uint64_t& quote) {
+        // a backslash escapes the next byte, unless it is escaped itself
+        uint64_t escaped = escapedCarry;
+        uint64_t escapes = m.backslash & ~escapedCarry;
+        escapedCarry = 0;
+        while (escapes != 0) {
+            int i = lowestBit(escapes);
+            if (i == 63) {
+                escapedCarry = 1;
+                break;
+            }
+            escaped |= uint64_t(2) << i;
+            escapes &= ~(uint64_t(3) << i);
         }
-        errno = 0;
-        number_ = strtod(context.subUnparsed(startIdx, context.idx() - startIdx).c_str(), nullptr);
-        if (errno == ERANGE && (number_ == HUGE_VAL || number_ == -HUGE_VAL)) {
+        quote = m.quote & ~escaped;
+        uint64_t inString = quote;
+        inString ^= inString << 1;
+        inString ^= inString << 2;
+        inString ^= inString << 4;
+        inString ^= inString << 8;
+        inString ^= inString << 16;
+        inString ^= inString << 32;
+        inString ^= inStringCarry;
+        inStringCarry = (inString >> 63) != 0 ? ~uint64_t(0) : 0;
+        return inString;
+    }
+    // the position of every token outside strings: structural chars, quotes
+    // and the first char of every other run (numbers, literals and stray chars),
+    // so that the char after a run of whitespace is always on the tape;
+    // len is below 2 GB, the high bit of an entry is TAPE_DECODE
+    static void indexStructure(const char* data, size_t len, std::vector<uint32_t>& tape) {
+        classifyBlock classify = selectIndexEngine().classify;
+        // written through a pointer, with room for a whole block kept ahead of it
+        tape.resize(len / 4 + 64);
+        size_t count = 0;
+        uint64_t escapedCarry = 0;  // the first byte of the next block is escaped
+        uint64_t inStringCarry = 0; // all ones while a string is open
+        uint64_t boundaryCarry = 1; // a run may start at the first byte of the next block
+        bool decodeCarry = false;   // the open string has escapes or control chars
+        char tail[64];
+        for (size_t base = 0; base < len; base += 64) {
+            blockMasks m;
+            if (len - base >= 64) {
+                classify(data + base, m);
+            } else {
+                // the last block, padded with whitespace which is never a token
+                memset(tail, ' ', sizeof(tail));
+                memcpy(tail, data + base, len - base);
+                classifyScalar(tail, m);
+            }
+            bool openAtStart = inStringCarry != 0;
+            uint64_t quote;
+            uint64_t inString = scanStrings(m, escapedCarry, inStringCarry, quote);
+            uint64_t boundary = m.op | m.space | (quote & ~inString);
+            uint64_t runStart = ~(m.op | m.space | quote | inString) & ((boundary << 1) | boundaryCarry);
+            boundaryCarry = boundary >> 63;
+            uint64_t tokens = (m.op & ~inString) | quote | runStart;
+            // the closing quotes of strings to decode, one string at a time if there are any
+            uint64_t special = (m.backslash | m.control) & inString;
+            uint64_t decodeQuotes = 0;
+            if (special != 0 || decodeCarry) {
+                bool open = openAtStart, decode = decodeCarry;
+                int from = 0;
+                for (uint64_t q = quote; q != 0; q &= q - 1) {
+                    int i = lowestBit(q);
+                    if (open) {
+                        uint64_t range = ((uint64_t(1) << i) - 1) & ~((uint64_t(1) << from) - 1);
+                        if (decode || (special & range) != 0) { decodeQuotes |= uint64_t(1) << i; }
+                    }
+                    open = !open;
+                    decode = false;
+                    from = i;
+                }
+                decodeCarry = open && (decode || (special >> from) != 0);
+            }
+            size_t tokenCount = (size_t)bitCount(tokens);
+            if (tape.size() - count < 64) {
+                tape.resize(tape.size() * 2);
+            }
+            // eight at a time without a branch per token, the writes past the last one are overwritten
+            uint32_t* out = tape.data() + count;
+            uint32_t at = (uint32_t)base;
+            while (tokens != 0) {
+                for (int k = 0; k < 8; ++ k) {
+                    out[k] = at + (uint32_t)lowestBit(tokens | (uint64_t(1) << 63));
+                    tokens &= tokens - 1;
+                }
+                out += 8;
+            }
+            for (size_t k = count; decodeQuotes != 0 && k < count + tokenCount; ++ k) {
+                if ((decodeQuotes >> (tape[k] - at)) & 1) { tape[k] |= TAPE_DECODE; }
+            }
+            count += tokenCount;
+        }
+        tape.resize(count);
+    }
+    // the array opened at data[start] is cut at the first comma between its elements past
+    // each of the targets, which are in order; returns the position of the bracket that
+    // closes it, or len if it is not closed
+    static size_t findElementCuts(const char* data, size_t len, size_t start,
+        const std::vector<size_t>& targets, std::vector<size_t>& cuts) {
+        classifyBlock classify = selectIndexEngine().classify;
+        uint64_t escapedCarry = 0, inStringCarry = 0;
+        size_t depth = 0, next = 0;
+        char tail[64];
+        for (size_t base = start - start % 64; base < len; base += 64) {
+            blockMasks m;
+            if (len - base >= 64) {
+                classify(data + base, m);
+            } else {
+                memset(tail, ' ', sizeof(tail));
+                memcpy(tail, data + base, len - base);
+                classifyScalar(tail, m);
+            }
+            uint64_t quote;
+            uint64_t ops = m.op & ~scanStrings(m, escapedCarry, inStringCarry, quote);
+            for (; ops != 0; ops &= ops - 1) {
+                size_t pos = base + lowestBit(ops);
+                switch (data[pos]) {
+                    case '[': case '{':
+                        ++ depth;
+                        break;
+                    case ']': case '}':
+                        if (-- depth == 0) {
+                            return pos;
+                        }
+                        break;
+                    case ',':
+                        if (depth == 1 && next < targets.size() && pos >= targets[next]) {
+                            cuts.push_back(pos);
+                            while (next < targets.size() && pos >= targets[next]) {
+                                ++ next;
+                            }
+                        }
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+        return len;
+    }
+
+
+
+
+    json::parseContext::parseContext(const char* data, size_t len, parser* reuse) {
+        unparsed_ = data;
+        len_ = len;
+        idx_ = 0;
+        reuse_ = reuse;
+        outer_ = 0;
+        if (reuse_ != nullptr) {
+            stack_.swap(reuse_->stack_);
+            elements_.swap(reuse_->elements_);
+            members_.swap(reuse_->members_);
+            levels_.swap(reuse_->levels_);
+            bases_.swap(reuse_->bases_);
+        }
+    }
+    json::parseContext::~parseContext() {
+        if (reuse_ != nullptr) {
+            stack_.clear();
+            elements_.clear();
+            members_.clear();
+            levels_.clear();
+            bases_.clear();
+            stack_.swap(reuse_->stack_);
+            elements_.swap(reuse_->elements_);
+            members_.swap(reuse_->members_);
+            levels_.swap(reuse_->levels_);
+            bases_.swap(reuse_->bases_);
+        }
+    }
+    size_t json::parseContext::idx() {
+        return idx_;
+    }
+    void json::parseContext::resetIdx(size_t idx) {
+        idx_ = idx;
+    }
+    bool json::parseContext::end() {
+        return idx_ >= len_;
+    }
+    char json::parseContext::cur() {
+        return idx_ < len_ ? unparsed_[idx_] : '\0';
+    }
+    char json::parseContext::curPass() {
+        return idx_ < len_ ? unparsed_[idx_ ++] : '\0';
+    }
+    const char* json::parseContext::curPtr() {
+        return unparsed_ + idx_;
+    }
+    size_t json::parseContext::left() {
+        return len_ - idx_;
+    }
+    void json::parseContext::pass(size_t n) {
+        idx_ += n;
+    }
+    std::string json::parseContext::subUnparsed(size_t startIdx, size_t len) {
+        return std::string(unparsed_ + startIdx, len);
+    }
+    void json::parseContext::stackPushCh(char ch) {
+        stack_ += ch;
+    }
+    void json::parseContext::stackPushStr(const char* str, size_t len) {
+        stack_.append(str, len);
+    }
+    void json::parseContext::stackPushStr(std::string str) {
+        stack_ += str;
+    }
+    std::string json::parseContext::stackPop(size_t len) {
+        std::string ret = stack_.substr(stack_.size() - len, len);
+        stack_.resize(stack_.size() - len);
+        return ret;
+    }
+    size_t json::parseContext::stackSize() {
+        return stack_.size();
+    }
+    const char* json::parseContext::stackAt(size_t idx) {
+        return stack_.data() + idx;
+    }
+    void json::parseContext::stackResize(size_t size) {
+        stack_.resize(size);
+    }
+    json::arrayType& json::parseContext::elements() {
+        return elements_;
+    }
+    json::objectType& json::parseContext::members() {
+        return members_;
+    }
+    std::vector<size_t>& json::parseContext::levels() {
+        return levels_;
+    }
+    std::vector<size_t>& json::parseContext::bases() {
+        return bases_;
+    }
+    size_t& json::parseContext::outer() {
+        return outer_;
+    }
+
+
+
+
+
+
+
+
+    void json::parseWhitespace(parseContext& context) {
+        char ch = context.cur();
+        while (ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r') {
+            context.curPass();
+            ch = context.cur();
+        }
+    }
+    json::jsonError json::parseLiteralRaw(parseContext& context, const char* literal) {
+        for (; *literal; ++ literal) {
+            if (*literal != context.curPass()) {
+                return JSON_PARSE_INVALID_VALUE;
+            }
+        }
+        return JSON_PARSE_OK;
+    }
+    std::atomic<size_t>& json::maxDepth() {
+        static std::atomic<size_t> depth(1000);
+        return depth;
+    }
+    void json::setMaxDepth(size_t depth) {
+        maxDepth().store(depth, std::memory_order_relaxed);
+    }
+    size_t json::getMaxDepth() {
+        return maxDepth().load(std::memory_order_relaxed);
+    }
+    // number conversion without strtod()
+    // 5^q truncated to its 128 most significant bits, q in [-342, 308]
+    static const uint64_t powerOfFive128[] = {
+        0xeef453d6923bd65a,0x113faa2906a13b3f, 0x9558b4661b6565f8,0x4ac7ca59a424c507,
+        0xbaaee17fa23ebf76,0x5d79bcf00d2df649, 0xe95a99df8ace6f53,0xf4d82c2c107973dc,
+        0x91d8a02bb6c10594,0x79071b9b8a4be869, 0xb64ec836a47146f9,0x9748e2826cdee284,
+        0xe3e27a444d8d98b7,0xfd1b1b2308169b25, 0x8e6d8c6ab0787f72,0xfe30f0f5e50e20f7,
+        0xb208ef855c969f4f,0xbdbd2d335e51a935, 0xde8b2b66b3bc4723,0xad2c788035e61382,
+        0x8b16fb203055ac76,0x4c3bcb5021afcc31, 0xaddcb9e83c6b1793,0xdf4abe242a1bbf3d,
+        0xd953e8624b85dd78,0xd71d6dad34a2af0d, 0x87d4713d6f33aa6b,0x8672648c40e5ad68,
+        0xa9c98d8ccb009506,0x680efdaf511f18c2, 0xd43bf0effdc0ba48,0x0212bd1b2566def2,
+        0x84a57695fe98746d,0x014bb630f7604b57, 0xa5ced43b7e3e9188,0x419ea3bd35385e2d,
+        0xcf42894a5dce35ea,0x52064cac828675b9, 0x818995ce7aa0e1b2,0x7343efebd1940993,
+        0xa1ebfb4219491a1f,0x1014ebe6c5f90bf8, 0xca66fa129f9b60a6,0xd41a26e077774ef6,
+        0xfd00b897478238d0,0x8920b098955522b4, 0x9e20735e8cb16382,0x55b46e5f5d5535b0,
+        0xc5a890362fddbc62,0xeb2189f734aa831d, 0xf712b443bbd52b7b,0xa5e9ec7501d523e4,
+        0x9a6bb0aa55653b2d,0x47b233c92125366e, 0xc1069cd4eabe89f8,0x999ec0bb696e840a,
+        0xf148440a256e2c76,0xc00670ea43ca250d, 0x96cd2a865764dbca,0x380406926a5e5728,
+        0xbc807527ed3e12bc,0xc605083704f5ecf2, 0xeba09271e88d976b,0xf7864a44c633682e,
+        0x93445b8731587ea3,0x7ab3ee6afbe0211d, 0xb8157268fdae9e4c,0x5960ea05bad82964,
+        0xe61acf033d1a45df,0x6fb92487298e33bd, 0x8fd0c16206306bab,0xa5d3b6d479f8e056,
+        0xb3c4f1ba87bc8696,0x8f48a4899877186c, 0xe0b62e2929aba83c,0x331acdabfe94de87,
+        0x8c71dcd9ba0b4925,0x9ff0c08b7f1d0b14, 0xaf8e5410288e1b6f,0x07ecf0ae5ee44dd9,
+        0xdb71e91432b1a24a,0xc9e82cd9f69d6150, 0x892731ac9faf056e,0xbe311c083a225cd2,
+        0xab70fe17c79ac6ca,0x6dbd630a48aaf406, 0xd64d3d9db981787d,0x092cbbccdad5b108,
+        0x85f0468293f0eb4e,0x25bbf56008c58ea5, 0xa76c582338ed2621,0xaf2af2b80af6f24e,
+        0xd1476e2c07286faa,0x1af5af660db4aee1, 0x82cca4db847945ca,0x50d98d9fc890ed4d,
+        0xa37fce126597973c,0xe50ff107bab528a0, 0xcc5fc196fefd7d0c,0x1e53ed49a96272c8,
+        0xff77b1fcbebcdc4f,0x25e8e89c13bb0f7a, 0x9faacf3df73609b1,0x77b191618c54e9ac,
+        0xc795830d75038c1d,0xd59df5b9ef6a2417, 0xf97ae3d0d2446f25,0x4b0573286b44ad1d,
+        0x9becce62836ac577,0x4ee367f9430aec32, 0xc2e801fb244576d5,0x229c41f793cda73f,
+        0xf3a20279ed56d48a,0x6b43527578c1110f, 0x9845418c345644d6,0x830a13896b78aaa9,
+        0xbe5691ef416bd60c,0x23cc986bc656d553, 0xedec366b11c6cb8f,0x2cbfbe86b7ec8aa8,
+        0x94b3a202eb1c3f39,0x7bf7d71432f3d6a9, 0xb9e08a83a5e34f07,0xdaf5ccd93fb0cc53,
+        0xe858ad248f5c22c9,0xd1b3400f8f9cff68, 0x91376c36d99995be,0x23100809b9c21fa1,
+        0xb58547448ffffb2d,0xabd40a0c2832a78a, 0xe2e69915b3fff9f9,0x16c90c8f323f516c,
+        0x8dd01fad907ffc3b,0xae3da7d97f6792e3, 0xb1442798f49ffb4a,0x99cd11cfdf41779c,
+        0xdd95317f31c7fa1d,0x40405643d711d583, 0x8a7d3eef7f1cfc52,0x482835ea666b2572,
+        0xad1c8eab5ee43b66,0xda3243650005eecf, 0xd863b256369d4a40,0x90bed43e40076a82,
+        0x873e4f75e2224e68,0x5a7744a6e804a291, 0xa90de3535aaae202,0x711515d0a205cb36,
+        0xd3515c2831559a83,0x0d5a5b44ca873e03, 0x8412d9991ed58091,0xe858790afe9486c2,
+        0xa5178fff668ae0b6,0x626e974dbe39a872, 0xce5d73ff402d98e3,0xfb0a3d212dc8128f,
+        0x80fa687f881c7f8e,0x7ce66634bc9d0b99, 0xa139029f6a239f72,0x1c1fffc1ebc44e80,
+        0xc987434744ac874e,0xa327ffb266b56220, 0xfbe9141915d7a922,0x4bf1ff9f0062baa8,
+        0x9d71ac8fada6c9b5,0x6f773fc3603db4a9, 0xc4ce17b399107c22,0xcb550fb4384d21d3,
+        0xf6019da07f549b2b,0x7e2a53a146606a48, 0x99c102844f94e0fb,0x2eda7444cbfc426d,
+        0xc0314325637a1939,0xfa911155fefb5308, 0xf03d93eebc589f88,0x793555ab7eba27ca,
+        0x96267c7535b763b5,0x4bc1558b2f3458de, 0xbbb01b9283253ca2,0x9eb1aaedfb016f16,
+        0xea9c227723ee8bcb,0x465e15a979c1cadc, 0x92a1958a7675175f,0x0bfacd89ec191ec9,
+        0xb749faed14125d36,0xcef980ec671f667b, 0xe51c79a85916f484,0x82b7e12780e7401a,
+        0x8f31cc0937ae58d2,0xd1b2ecb8b0908810, 0xb2fe3f0b8599ef07,0x861fa7e6dcb4aa15,
+        0xdfbdcece67006ac9,0x67a791e093e1d49a, 0x8bd6a141006042bd,0xe0c8bb2c5c6d24e0,
+        0xaecc49914078536d,0x58fae9f773886e18, 0xda7f5bf590966848,0xaf39a475506a899e,
+        0x888f99797a5e012d,0x6d8406c952429603, 0xaab37fd7d8f58178,0xc8e5087ba6d33b83,
+        0xd5605fcdcf32e1d6,0xfb1e4a9a90880a64, 0x855c3be0a17fcd26,0x5cf2eea09a55067f,
+        0xa6b34ad8c9dfc06f,0xf42faa48c0ea481e, 0xd0601d8efc57b08b,0xf13b94daf124da26,
+        0x823c12795db6ce57,0x76c53d08d6b70858, 0xa2cb1717b52481ed,0x54768c4b0c64ca6e,
+        0xcb7ddcdda26da268,0xa9942f5dcf7dfd09, 0xfe5d54150b090b02,0xd3f93b35435d7c4c,
+        0x9efa548d26e5a6e1,0xc47bc5014a1a6daf, 0xc6b8e9b0709f109a,0x359ab6419ca1091b,
+        0xf867241c8cc6d4c0,0xc30163d203c94b62, 0x9b407691d7fc44f8,0x79e0de63425dcf1d,
+        0xc21094364dfb5636,0x985915fc12f542e4, 0xf294b943e17a2bc4,0x3e6f5b7b17b2939d,
+        0x979cf3ca6cec5b5a,0xa705992ceecf9c42, 0xbd8430bd08277231,0x50c6ff782a838353,
+        0xece53cec4a314ebd,0xa4f8bf5635246428, 0x940f4613ae5ed136,0x871b7795e136be99,
+        0xb913179899f68584,0x28e2557b59846e3f, 0xe757dd7ec07426e5,0x331aeada2fe589cf,
+        0x9096ea6f3848984f,0x3ff0d2c85def7621, 0xb4bca50b065abe63,0x0fed077a756b53a9,
+        0xe1ebce4dc7f16dfb,0xd3e8495912c62894, 0x8d3360f09cf6e4bd,0x64712dd7abbbd95c,
+        0xb080392cc4349dec,0xbd8d794d96aacfb3, 0xdca04777f541c567,0xecf0d7a0fc5583a0,
+        0x89e42caaf9491b60,0xf41686c49db57244, 0xac5d37d5b79b6239,0x311c2875c522ced5,
+        0xd77485cb25823ac7,0x7d633293366b828b, 0x86a8d39ef77164bc,0xae5dff9c02033197,
+        0xa8530886b54dbdeb,0xd9f57f830283fdfc, 0xd267caa862a12d66,0xd072df63c324fd7b,
+        0x8380dea93da4bc60,0x4247cb9e59f71e6d, 0xa46116538d0deb78,0x52d9be85f074e608,
+        0xcd795be870516656,0x67902e276c921f8b, 0x806bd9714632dff6,0x00ba1cd8a3db53b6,
+        0xa086cfcd97bf97f3,0x80e8a40eccd228a4, 0xc8a883c0fdaf7df0,0x6122cd128006b2cd,
+        0xfad2a4b13d1b5d6c,0x796b805720085f81, 0x9cc3a6eec6311a63,0xcbe3303674053bb0,
+        0xc3f490aa77bd60fc,0xbedbfc4411068a9c, 0xf4f1b4d515acb93b,0xee92fb5515482d44,
+        0x991711052d8bf3c5,0x751bdd152d4d1c4a, 0xbf5cd54678eef0b6,0xd262d45a78a0635d,
+        0xef340a98172aace4,0x86fb897116c87c34, 0x9580869f0e7aac0e,0xd45d35e6ae3d4da0,
+        0xbae0a846d2195712,0x8974836059cca109, 0xe998d258869facd7,0x2bd1a438703fc94b,
+        0x91ff83775423cc06,0x7b6306a34627ddcf, 0xb67f6455292cbf08,0x1a3bc84c17b1d542,
+        0xe41f3d6a7377eeca,0x20caba5f1d9e4a93, 0x8e938662882af53e,0x547eb47b7282ee9c,
+        0xb23867fb2a35b28d,0xe99e619a4f23aa43, 0xdec681f9f4c31f31,0x6405fa00e2ec94d4,
+        0x8b3c113c38f9f37e,0xde83bc408dd3dd04, 0xae0b158b4738705e,0x9624ab50b148d445,
+        0xd98ddaee19068c76,0x3badd624dd9b0957, 0x87f8a8d4cfa417c9,0xe54ca5d70a80e5d6,
+        0xa9f6d30a038d1dbc,0x5e9fcf4ccd211f4c, 0xd47487cc8470652b,0x7647c3200069671f,
+        0x84c8d4dfd2c63f3b,0x29ecd9f40041e073, 0xa5fb0a17c777cf09,0xf468107100525890,
+        0xcf79cc9db955c2cc,0x7182148d4066eeb4, 0x81ac1fe293d599bf,0xc6f14cd848405530,
+        0xa21727db38cb002f,0xb8ada00e5a506a7c, 0xca9cf1d206fdc03b,0xa6d90811f0e4851c,
+        0xfd442e4688bd304a,0x908f4a166d1da663, 0x9e4a9cec15763e2e,0x9a598e4e043287fe,
+        0xc5dd44271ad3cdba,0x40eff1e1853f29fd, 0xf7549530e188c128,0xd12bee59e68ef47c,
+        0x9a94dd3e8cf578b9,0x82bb74f8301958ce, 0xc13a148e3032d6e7,0xe36a52363c1faf01,
+        0xf18899b1bc3f8ca1,0xdc44e6c3cb279ac1, 0x96f5600f15a7b7e5,0x29ab103a5ef8c0b9,
+        0xbcb2b812db11a5de,0x7415d448f6b6f0e7, 0xebdf661791d60f56,0x111b495b3464ad21,
+        0x936b9fcebb25c995,0xcab10dd900beec34, 0xb84687c269ef3bfb,0x3d5d514f40eea742,
+        0xe65829b3046b0afa,0x0cb4a5a3112a5112, 0x8ff71a0fe2c2e6dc,0x47f0e785eaba72ab,
+        0xb3f4e093db73a093,0x59ed216765690f56, 0xe0f218b8d25088b8,0x306869c13ec3532c,
+        0x8c974f7383725573,0x1e414218c73a13fb, 0xafbd2350644eeacf,0xe5d1929ef90898fa,
+        0xdbac6c247d62a583,0xdf45f746b74abf39, 0x894bc396ce5da772,0x6b8bba8c328eb783,
+        0xab9eb47c81f5114f,0x066ea92f3f326564, 0xd686619ba27255a2,0xc80a537b0efefebd,
+        0x8613fd0145877585,0xbd06742ce95f5f36, 0xa798fc4196e952e7,0x2c48113823b73704,
+        0xd17f3b51fca3a7a0,0xf75a15862ca504c5, 0x82ef85133de648c4,0x9a984d73dbe722fb,
+        0xa3ab66580d5fdaf5,0xc13e60d0d2e0ebba, 0xcc963fee10b7d1b3,0x318df905079926a8,
+        0xffbbcfe994e5c61f,0xfdf17746497f7052, 0x9fd561f1fd0f9bd3,0xfeb6ea8bedefa633,
+        0xc7caba6e7c5382c8,0xfe64a52ee96b8fc0, 0xf9bd690a1b68637b,0x3dfdce7aa3c673b0,
+        0x9c1661a651213e2d,0x06bea10ca65c084e, 0xc31bfa0fe5698db8,0x486e494fcff30a62,
+        0xf3e2f893dec3f126,0x5a89dba3c3efccfa, 0x986ddb5c6b3a76b7,0xf89629465a75e01c,
+        0xbe89523386091465,0xf6bbb397f1135823, 0xee2ba6c0678b597f,0x746aa07ded582e2c,
+        0x94db483840b717ef,0xa8c2a44eb4571cdc, 0xba121a4650e4ddeb,0x92f34d62616ce413,
+        0xe896a0d7e51e1566,0x77b020baf9c81d17, 0x915e2486ef32cd60,0x0ace1474dc1d122e,
+        0xb5b5ada8aaff80b8,0x0d819992132456ba, 0xe3231912d5bf60e6,0x10e1fff697ed6c69,
+        0x8df5efabc5979c8f,0xca8d3ffa1ef463c1, 0xb1736b96b6fd83b3,0xbd308ff8a6b17cb2,
+        0xddd0467c64bce4a0,0xac7cb3f6d05ddbde, 0x8aa22c0dbef60ee4,0x6bcdf07a423aa96b,
+        0xad4ab7112eb3929d,0x86c16c98d2c953c6, 0xd89d64d57a607744,0xe871c7bf077ba8b7,
+        0x87625f056c7c4a8b,0x11471cd764ad4972, 0xa93af6c6c79b5d2d,0xd598e40d3dd89bcf,
+        0xd389b47879823479,0x4aff1d108d4ec2c3, 0x843610cb4bf160cb,0xcedf722a585139ba,
+        0xa54394fe1eedb8fe,0xc2974eb4ee658828, 0xce947a3da6a9273e,0x733d226229feea32,
+        0x811ccc668829b887,0x0806357d5a3f525f, 0xa163ff802a3426a8,0xca07c2dcb0cf26f7,
+        0xc9bcff6034c13052,0xfc89b393dd02f0b5, 0xfc2c3f3841f17c67,0xbbac2078d443ace2,
+        0x9d9ba7832936edc0,0xd54b944b84aa4c0d, 0xc5029163f384a931,0x0a9e795e65d4df11,
+        0xf64335bcf065d37d,0x4d4617b5ff4a16d5, 0x99ea0196163fa42e,0x504bced1bf8e4e45,
+        0xc06481fb9bcf8d39,0xe45ec2862f71e1d6, 0xf07da27a82c37088,0x5d767327bb4e5a4c,
+        0x964e858c91ba2655,0x3a6a07f8d510f86f, 0xbbe226efb628afea,0x890489f70a55368b,
+        0xeadab0aba3b2dbe5,0x2b45ac74ccea842e, 0x92c8ae6b464fc96f,0x3b0b8bc90012929d,
+        0xb77ada0617e3bbcb,0x09ce6ebb40173744, 0xe55990879ddcaabd,0xcc420a6a101d0515,
+        0x8f57fa54c2a9eab6,0x9fa946824a12232d, 0xb32df8e9f3546564,0x47939822dc96abf9,
+        0xdff9772470297ebd,0x59787e2b93bc56f7, 0x8bfbea76c619ef36,0x57eb4edb3c55b65a,
+        0xaefae51477a06b03,0xede622920b6b23f1, 0xdab99e59958885c4,0xe95fab368e45eced,
+        0x88b402f7fd75539b,0x11dbcb0218ebb414, 0xaae103b5fcd2a881,0xd652bdc29f26a119,
+        0xd59944a37c0752a2,0x4be76d3346f0495f, 0x857fcae62d8493a5,0x6f70a4400c562ddb,
+        0xa6dfbd9fb8e5b88e,0xcb4ccd500f6bb952, 0xd097ad07a71f26b2,0x7e2000a41346a7a7,
+        0x825ecc24c873782f,0x8ed400668c0c28c8, 0xa2f67f2dfa90563b,0x728900802f0f32fa,
+        0xcbb41ef979346bca,0x4f2b40a03ad2ffb9, 0xfea126b7d78186bc,0xe2f610c84987bfa8,
+        0x9f24b832e6b0f436,0x0dd9ca7d2df4d7c9, 0xc6ede63fa05d3143,0x91503d1c79720dbb,
+        0xf8a95fcf88747d94,0x75a44c6397ce912a, 0x9b69dbe1b548ce7c,0xc986afbe3ee11aba,
+        0xc24452da229b021b,0xfbe85badce996168, 0xf2d56790ab41c2a2,0xfae27299423fb9c3,
+        0x97c560ba6b0919a5,0xdccd879fc967d41a, 0xbdb6b8e905cb600f,0x5400e987bbc1c920,
+        0xed246723473e3813,0x290123e9aab23b68, 0x9436c0760c86e30b,0xf9a0b6720aaf6521,
+        0xb94470938fa89bce,0xf808e40e8d5b3e69, 0xe7958cb87392c2c2,0xb60b1d1230b20e04,
+        0x90bd77f3483bb9b9,0xb1c6f22b5e6f48c2, 0xb4ecd5f01a4aa828,0x1e38aeb6360b1af3,
+        0xe2280b6c20dd5232,0x25c6da63c38de1b0, 0x8d590723948a535f,0x579c487e5a38ad0e,
+        0xb0af48ec79ace837,0x2d835a9df0c6d851, 0xdcdb1b2798182244,0xf8e431456cf88e65,
+        0x8a08f0f8bf0f156b,0x1b8e9ecb641b58ff, 0xac8b2d36eed2dac5,0xe272467e3d222f3f,
+        0xd7adf884aa879177,0x5b0ed81dcc6abb0f, 0x86ccbb52ea94baea,0x98e947129fc2b4e9,
+        0xa87fea27a539e9a5,0x3f2398d747b36224, 0xd29fe4b18e88640e,0x8eec7f0d19a03aad,
+        0x83a3eeeef9153e89,0x1953cf68300424ac, 0xa48ceaaab75a8e2b,0x5fa8c3423c052dd7,
+        0xcdb02555653131b6,0x3792f412cb06794d, 0x808e17555f3ebf11,0xe2bbd88bbee40bd0,
+        0xa0b19d2ab70e6ed6,0x5b6aceaeae9d0ec4, 0xc8de047564d20a8b,0xf245825a5a445275,
+        0xfb158592be068d2e,0xeed6e2f0f0d56712, 0x9ced737bb6c4183d,0x55464dd69685606b,
+        0xc428d05aa4751e4c,0xaa97e14c3c26b886, 0xf53304714d9265df,0xd53dd99f4b3066a8,
+        0x993fe2c6d07b7fab,0xe546a8038efe4029, 0xbf8fdb78849a5f96,0xde98520472bdd033,
+        0xef73d256a5c0f77c,0x963e66858f6d4440, 0x95a8637627989aad,0xdde7001379a44aa8,
+        0xbb127c53b17ec159,0x5560c018580d5d52, 0xe9d71b689dde71af,0xaab8f01e6e10b4a6,
+        0x9226712162ab070d,0xcab3961304ca70e8, 0xb6b00d69bb55c8d1,0x3d607b97c5fd0d22,
+        0xe45c10c42a2b3b05,0x8cb89a7db77c506a, 0x8eb98a7a9a5b04e3,0x77f3608e92adb242,
+        0xb267ed1940f1c61c,0x55f038b237591ed3, 0xdf01e85f912e37a3,0x6b6c46dec52f6688,
+        0x8b61313bbabce2c6,0x2323ac4b3b3da015, 0xae397d8aa96c1b77,0xabec975e0a0d081a,
+        0xd9c7dced53c72255,0x96e7bd358c904a21, 0x881cea14545c7575,0x7e50d64177da2e54,
+        0xaa242499697392d2,0xdde50bd1d5d0b9e9, 0xd4ad2dbfc3d07787,0x955e4ec64b44e864,
+        0x84ec3c97da624ab4,0xbd5af13bef0b113e, 0xa6274bbdd0fadd61,0xecb1ad8aeacdd58e,
+        0xcfb11ead453994ba,0x67de18eda5814af2, 0x81ceb32c4b43fcf4,0x80eacf948770ced7,
+        0xa2425ff75e14fc31,0xa1258379a94d028d, 0xcad2f7f5359a3b3e,0x096ee45813a04330,
+        0xfd87b5f28300ca0d,0x8bca9d6e188853fc, 0x9e74d1b791e07e48,0x775ea264cf55347e,
+        0xc612062576589dda,0x95364afe032a819e, 0xf79687aed3eec551,0x3a83ddbd83f52205,
+        0x9abe14cd44753b52,0xc4926a9672793543, 0xc16d9a0095928a27,0x75b7053c0f178294,
+        0xf1c90080baf72cb1,0x5324c68b12dd6339, 0x971da05074da7bee,0xd3f6fc16ebca5e04,
+        0xbce5086492111aea,0x88f4bb1ca6bcf585, 0xec1e4a7db69561a5,0x2b31e9e3d06c32e6,
+        0x9392ee8e921d5d07,0x3aff322e62439fd0, 0xb877aa3236a4b449,0x09befeb9fad487c3,
+        0xe69594bec44de15b,0x4c2ebe687989a9b4, 0x901d7cf73ab0acd9,0x0f9d37014bf60a11,
+        0xb424dc35095cd80f,0x538484c19ef38c95, 0xe12e13424bb40e13,0x2865a5f206b06fba,
+        0x8cbccc096f5088cb,0xf93f87b7442e45d4, 0xafebff0bcb24aafe,0xf78f69a51539d749,
+        0xdbe6fecebdedd5be,0xb573440e5a884d1c, 0x89705f4136b4a597,0x31680a88f8953031,
+        0xabcc77118461cefc,0xfdc20d2b36ba7c3e, 0xd6bf94d5e57a42bc,0x3d32907604691b4d,
+        0x8637bd05af6c69b5,0xa63f9a49c2c1b110, 0xa7c5ac471b478423,0x0fcf80dc33721d54,
+        0xd1b71758e219652b,0xd3c36113404ea4a9, 0x83126e978d4fdf3b,0x645a1cac083126ea,
+        0xa3d70a3d70a3d70a,0x3d70a3d70a3d70a4, 0xcccccccccccccccc,0xcccccccccccccccd,
+        0x8000000000000000,0x0000000000000000, 0xa000000000000000,0x0000000000000000,
+        0xc800000000000000,0x0000000000000000, 0xfa00000000000000,0x0000000000000000,
+        0x9c40000000000000,0x0000000000000000, 0xc350000000000000,0x0000000000000000,
+        0xf424000000000000,0x0000000000000000, 0x9896800000000000,0x0000000000000000,
+        0xbebc200000000000,0x0000000000000000, 0xee6b280000000000,0x0000000000000000,
+        0x9502f90000000000,0x0000000000000000, 0xba43b74000000000,0x0000000000000000,
+        0xe8d4a51000000000,0x0000000000000000, 0x9184e72a00000000,0x0000000000000000,
+        0xb5e620f480000000,0x0000000000000000, 0xe35fa931a0000000,0x0000000000000000,
+        0x8e1bc9bf04000000,0x0000000000000000, 0xb1a2bc2ec5000000,0x0000000000000000,
+        0xde0b6b3a76400000,0x0000000000000000, 0x8ac7230489e80000,0x0000000000000000,
+        0xad78ebc5ac620000,0x0000000000000000, 0xd8d726b7177a8000,0x0000000000000000,
+        0x878678326eac9000,0x0000000000000000, 0xa968163f0a57b400,0x0000000000000000,
+        0xd3c21bcecceda100,0x0000000000000000, 0x84595161401484a0,0x0000000000000000,
+        0xa56fa5b99019a5c8,0x0000000000000000, 0xcecb8f27f4200f3a,0x0000000000000000,
+        0x813f3978f8940984,0x4000000000000000, 0xa18f07d736b90be5,0x5000000000000000,
+        0xc9f2c9cd04674ede,0xa400000000000000, 0xfc6f7c4045812296,0x4d00000000000000,
+        0x9dc5ada82b70b59d,0xf020000000000000, 0xc5371912364ce305,0x6c28000000000000,
+        0xf684df56c3e01bc6,0xc732000000000000, 0x9a130b963a6c115c,0x3c7f400000000000,
+        0xc097ce7bc90715b3,0x4b9f100000000000, 0xf0bdc21abb48db20,0x1e86d40000000000,
+        0x96769950b50d88f4,0x1314448000000000, 0xbc143fa4e250eb31,0x17d955a000000000,
+        0xeb194f8e1ae525fd,0x5dcfab0800000000, 0x92efd1b8d0cf37be,0x5aa1cae500000000,
+        0xb7abc627050305ad,0xf14a3d9e40000000, 0xe596b7b0c643c719,0x6d9ccd05d0000000,
+        0x8f7e32ce7bea5c6f,0xe4820023a2000000, 0xb35dbf821ae4f38b,0xdda2802c8a800000,
+        0xe0352f62a19e306e,0xd50b2037ad200000, 0x8c213d9da502de45,0x4526f422cc340000,
+        0xaf298d050e4395d6,0x9670b12b7f410000, 0xdaf3f04651d47b4c,0x3c0cdd765f114000,
+        0x88d8762bf324cd0f,0xa5880a69fb6ac800, 0xab0e93b6efee0053,0x8eea0d047a457a00,
+        0xd5d238a4abe98068,0x72a4904598d6d880, 0x85a36366eb71f041,0x47a6da2b7f864750,
+        0xa70c3c40a64e6c51,0x999090b65f67d924, 0xd0cf4b50cfe20765,0xfff4b4e3f741cf6d,
+        0x82818f1281ed449f,0xbff8f10e7a8921a4, 0xa321f2d7226895c7,0xaff72d52192b6a0d,
+        0xcbea6f8ceb02bb39,0x9bf4f8a69f764490, 0xfee50b7025c36a08,0x02f236d04753d5b4,
+        0x9f4f2726179a2245,0x01d762422c946590, 0xc722f0ef9d80aad6,0x424d3ad2b7b97ef5,
+        0xf8ebad2b84e0d58b,0xd2e0898765a7deb2, 0x9b934c3b330c8577,0x63cc55f49f88eb2f,
+        0xc2781f49ffcfa6d5,0x3cbf6b71c76b25fb, 0xf316271c7fc3908a,0x8bef464e3945ef7a,
+        0x97edd871cfda3a56,0x97758bf0e3cbb5ac, 0xbde94e8e43d0c8ec,0x3d52eeed1cbea317,
+        0xed63a231d4c4fb27,0x4ca7aaa863ee4bdd, 0x945e455f24fb1cf8,0x8fe8caa93e74ef6a,
+        0xb975d6b6ee39e436,0xb3e2fd538e122b44, 0xe7d34c64a9c85d44,0x60dbbca87196b616,
+        0x90e40fbeea1d3a4a,0xbc8955e946fe31cd, 0xb51d13aea4a488dd,0x6babab6398bdbe41,
+        0xe264589a4dcdab14,0xc696963c7eed2dd1, 0x8d7eb76070a08aec,0xfc1e1de5cf543ca2,
+        0xb0de65388cc8ada8,0x3b25a55f43294bcb, 0xdd15fe86affad912,0x49ef0eb713f39ebe,
+        0x8a2dbf142dfcc7ab,0x6e3569326c784337, 0xacb92ed9397bf996,0x49c2c37f07965404,
+        0xd7e77a8f87daf7fb,0xdc33745ec97be906, 0x86f0ac99b4e8dafd,0x69a028bb3ded71a3,
+        0xa8acd7c0222311bc,0xc40832ea0d68ce0c, 0xd2d80db02aabd62b,0xf50a3fa490c30190,
+        0x83c7088e1aab65db,0x792667c6da79e0fa, 0xa4b8cab1a1563f52,0x577001b891185938,
+        0xcde6fd5e09abcf26,0xed4c0226b55e6f86, 0x80b05e5ac60b6178,0x544f8158315b05b4,
+        0xa0dc75f1778e39d6,0x696361ae3db1c721, 0xc913936dd571c84c,0x03bc3a19cd1e38e9,
+        0xfb5878494ace3a5f,0x04ab48a04065c723, 0x9d174b2dcec0e47b,0x62eb0d64283f9c76,
+        0xc45d1df942711d9a,0x3ba5d0bd324f8394, 0xf5746577930d6500,0xca8f44ec7ee36479,
+        0x9968bf6abbe85f20,0x7e998b13cf4e1ecb, 0xbfc2ef456ae276e8,0x9e3fedd8c321a67e,
+        0xefb3ab16c59b14a2,0xc5cfe94ef3ea101e, 0x95d04aee3b80ece5,0xbba1f1d158724a12,
+        0xbb445da9ca61281f,0x2a8a6e45ae8edc97, 0xea1575143cf97226,0xf52d09d71a3293bd,
+        0x924d692ca61be758,0x593c2626705f9c56, 0xb6e0c377cfa2e12e,0x6f8b2fb00c77836c,
+        0xe498f455c38b997a,0x0b6dfb9c0f956447, 0x8edf98b59a373fec,0x4724bd4189bd5eac,
+        0xb2977ee300c50fe7,0x58edec91ec2cb657, 0xdf3d5e9bc0f653e1,0x2f2967b66737e3ed,
+        0x8b865b215899f46c,0xbd79e0d20082ee74, 0xae67f1e9aec07187,0xecd8590680a3aa11,
+        0xda01ee641a708de9,0xe80e6f4820cc9495, 0x884134fe908658b2,0x3109058d147fdcdd,
+        0xaa51823e34a7eede,0xbd4b46f0599fd415, 0xd4e5e2cdc1d1ea96,0x6c9e18ac7007c91a,
+        0x850fadc09923329e,0x03e2cf6bc604ddb0, 0xa6539930bf6bff45,0x84db8346b786151c,
+        0xcfe87f7cef46ff16,0xe612641865679a63, 0x81f14fae158c5f6e,0x4fcb7e8f3f60c07e,
+        0xa26da3999aef7749,0xe3be5e330f38f09d, 0xcb090c8001ab551c,0x5cadf5bfd3072cc5,
+        0xfdcb4fa002162a63,0x73d9732fc7c8f7f6, 0x9e9f11c4014dda7e,0x2867e7fddcdd9afa,
+        0xc646d63501a1511d,0xb281e1fd541501b8, 0xf7d88bc24209a565,0x1f225a7ca91a4226,
+        0x9ae757596946075f,0x3375788de9b06958, 0xc1a12d2fc3978937,0x0052d6b1641c83ae,
+        0xf209787bb47d6b84,0xc0678c5dbd23a49a, 0x9745eb4d50ce6332,0xf840b7ba963646e0,
+        0xbd176620a501fbff,0xb650e5a93bc3d898, 0xec5d3fa8ce427aff,0xa3e51f138ab4cebe,
+        0x93ba47c980e98cdf,0xc66f336c36b10137, 0xb8a8d9bbe123f017,0xb80b0047445d4184,
+        0xe6d3102ad96cec1d,0xa60dc059157491e5, 0x9043ea1ac7e41392,0x87c89837ad68db2f,
+        0xb454e4a179dd1877,0x29babe4598c311fb, 0xe16a1dc9d8545e94,0xf4296dd6fef3d67a,
+        0x8ce2529e2734bb1d,0x1899e4a65f58660c, 0xb01ae745b101e9e4,0x5ec05dcff72e7f8f,
+        0xdc21a1171d42645d,0x76707543f4fa1f73, 0x899504ae72497eba,0x6a06494a791c53a8,
+        0xabfa45da0edbde69,0x0487db9d17636892, 0xd6f8d7509292d603,0x45a9d2845d3c42b6,
+        0x865b86925b9bc5c2,0x0b8a2392ba45a9b2, 0xa7f26836f282b732,0x8e6cac7768d7141e,
+        0xd1ef0244af2364ff,0x3207d795430cd926, 0x8335616aed761f1f,0x7f44e6bd49e807b8,
+        0xa402b9c5a8d3a6e7,0x5f16206c9c6209a6, 0xcd036837130890a1,0x36dba887c37a8c0f,
+        0x802221226be55a64,0xc2494954da2c9789, 0xa02aa96b06deb0fd,0xf2db9baa10b7bd6c,
+        0xc83553c5c8965d3d,0x6f92829494e5acc7, 0xfa42a8b73abbf48c,0xcb772339ba1f17f9,
+        0x9c69a97284b578d7,0xff2a760414536efb, 0xc38413cf25e2d70d,0xfef5138519684aba,
+        0xf46518c2ef5b8cd1,0x7eb258665fc25d69, 0x98bf2f79d5993802,0xef2f773ffbd97a61,
+        0xbeeefb584aff8603,0xaafb550ffacfd8fa, 0xeeaaba2e5dbf6784,0x95ba2a53f983cf38,
+        0x952ab45cfa97a0b2,0xdd945a747bf26183, 0xba756174393d88df,0x94f971119aeef9e4,
+        0xe912b9d1478ceb17,0x7a37cd5601aab85d, 0x91abb422ccb812ee,0xac62e055c10ab33a,
+        0xb616a12b7fe617aa,0x577b986b314d6009, 0xe39c49765fdf9d94,0xed5a7e85fda0b80b,
+        0x8e41ade9fbebc27d,0x14588f13be847307, 0xb1d219647ae6b31c,0x596eb2d8ae258fc8,
+        0xde469fbd99a05fe3,0x6fca5f8ed9aef3bb, 0x8aec23d680043bee,0x25de7bb9480d5854,
+        0xada72ccc20054ae9,0xaf561aa79a10ae6a, 0xd910f7ff28069da4,0x1b2ba1518094da04,
+        0x87aa9aff79042286,0x90fb44d2f05d0842, 0xa99541bf57452b28,0x353a1607ac744a53,
+        0xd3fa922f2d1675f2,0x42889b8997915ce8, 0x847c9b5d7c2e09b7,0x69956135febada11,
+        0xa59bc234db398c25,0x43fab9837e699095, 0xcf02b2c21207ef2e,0x94f967e45e03f4bb,
+        0x8161afb94b44f57d,0x1d1be0eebac278f5, 0xa1ba1ba79e1632dc,0x6462d92a69731732,
+        0xca28a291859bbf93,0x7d7b8f7503cfdcfe, 0xfcb2cb35e702af78,0x5cda735244c3d43e,
+        0x9defbf01b061adab,0x3a0888136afa64a7, 0xc56baec21c7a1916,0x088aaa1845b8fdd0,
+        0xf6c69a72a3989f5b,0x8aad549e57273d45, 0x9a3c2087a63f6399,0x36ac54e2f678864b,
+        0xc0cb28a98fcf3c7f,0x84576a1bb416a7dd, 0xf0fdf2d3f3c30b9f,0x656d44a2a11c51d5,
+        0x969eb7c47859e743,0x9f644ae5a4b1b325, 0xbc4665b596706114,0x873d5d9f0dde1fee,
+        0xeb57ff22fc0c7959,0xa90cb506d155a7ea, 0x9316ff75dd87cbd8,0x09a7f12442d588f2,
+        0xb7dcbf5354e9bece,0x0c11ed6d538aeb2f, 0xe5d3ef282a242e81,0x8f1668c8a86da5fa,
+        0x8fa475791a569d10,0xf96e017d694487bc, 0xb38d92d760ec4455,0x37c981dcc395a9ac,
+        0xe070f78d3927556a,0x85bbe253f47b1417, 0x8c469ab843b89562,0x93956d7478ccec8e,
+        0xaf58416654a6babb,0x387ac8d1970027b2, 0xdb2e51bfe9d0696a,0x06997b05fcc0319e,
+        0x88fcf317f22241e2,0x441fece3bdf81f03, 0xab3c2fddeeaad25a,0xd527e81cad7626c3,
+        0xd60b3bd56a5586f1,0x8a71e223d8d3b074, 0x85c7056562757456,0xf6872d5667844e49,
+        0xa738c6bebb12d16c,0xb428f8ac016561db, 0xd106f86e69d785c7,0xe13336d701beba52,
+        0x82a45b450226b39c,0xecc0024661173473, 0xa34d721642b06084,0x27f002d7f95d0190,
+        0xcc20ce9bd35c78a5,0x31ec038df7b441f4, 0xff290242c83396ce,0x7e67047175a15271,
+        0x9f79a169bd203e41,0x0f0062c6e984d386, 0xc75809c42c684dd1,0x52c07b78a3e60868,
+        0xf92e0c3537826145,0xa7709a56ccdf8a82, 0x9bbcc7a142b17ccb,0x88a66076400bb691,
+        0xc2abf989935ddbfe,0x6acff893d00ea435, 0xf356f7ebf83552fe,0x0583f6b8c4124d43,
+        0x98165af37b2153de,0xc3727a337a8b704a, 0xbe1bf1b059e9a8d6,0x744f18c0592e4c5c,
+        0xeda2ee1c7064130c,0x1162def06f79df73, 0x9485d4d1c63e8be7,0x8addcb5645ac2ba8,
+        0xb9a74a0637ce2ee1,0x6d953e2bd7173692, 0xe8111c87c5c1ba99,0xc8fa8db6ccdd0437,
+        0x910ab1d4db9914a0,0x1d9c9892400a22a2, 0xb54d5e4a127f59c8,0x2503beb6d00cab4b,
+        0xe2a0b5dc971f303a,0x2e44ae64840fd61d, 0x8da471a9de737e24,0x5ceaecfed289e5d2,
+        0xb10d8e1456105dad,0x7425a83e872c5f47, 0xdd50f1996b947518,0xd12f124e28f77719,
+        0x8a5296ffe33cc92f,0x82bd6b70d99aaa6f, 0xace73cbfdc0bfb7b,0x636cc64d1001550b,
+        0xd8210befd30efa5a,0x3c47f7e05401aa4e, 0x8714a775e3e95c78,0x65acfaec34810a71,
+        0xa8d9d1535ce3b396,0x7f1839a741a14d0d, 0xd31045a8341ca07c,0x1ede48111209a050,
+        0x83ea2b892091e44d,0x934aed0aab460432, 0xa4e4b66b68b65d60,0xf81da84d5617853f,
+        0xce1de40642e3f4b9,0x36251260ab9d668e, 0x80d2ae83e9ce78f3,0xc1d72b7c6b426019,
+        0xa1075a24e4421730,0xb24cf65b8612f81f, 0xc94930ae1d529cfc,0xdee033f26797b627,
+        0xfb9b7cd9a4a7443c,0x169840ef017da3b1, 0x9d412e0806e88aa5,0x8e1f289560ee864e,
+        0xc491798a08a2ad4e,0xf1a6f2bab92a27e2, 0xf5b5d7ec8acb58a2,0xae10af696774b1db,
+        0x9991a6f3d6bf1765,0xacca6da1e0a8ef29, 0xbff610b0cc6edd3f,0x17fd090a58d32af3,
+        0xeff394dcff8a948e,0xddfc4b4cef07f5b0, 0x95f83d0a1fb69cd9,0x4abdaf101564f98e,
+        0xbb764c4ca7a4440f,0x9d6d1ad41abe37f1, 0xea53df5fd18d5513,0x84c86189216dc5ed,
+        0x92746b9be2f8552c,0x32fd3cf5b4e49bb4, 0xb7118682dbb66a77,0x3fbc8c33221dc2a1,
+        0xe4d5e82392a40515,0x0fabaf3feaa5334a, 0x8f05b1163ba6832d,0x29cb4d87f2a7400e,
+        0xb2c71d5bca9023f8,0x743e20e9ef511012, 0xdf78e4b2bd342cf6,0x914da9246b255416,
+        0x8bab8eefb6409c1a,0x1ad089b6c2f7548e, 0xae9672aba3d0c320,0xa184ac2473b529b1,
+        0xda3c0f568cc4f3e8,0xc9e5d72d90a2741e, 0x8865899617fb1871,0x7e2fa67c7a658892,
+        0xaa7eebfb9df9de8d,0xddbb901b98feeab7, 0xd51ea6fa85785631,0x552a74227f3ea565,
+        0x8533285c936b35de,0xd53a88958f87275f, 0xa67ff273b8460356,0x8a892abaf368f137,
+        0xd01fef10a657842c,0x2d2b7569b0432d85, 0x8213f56a67f6b29b,0x9c3b29620e29fc73,
+        0xa298f2c501f45f42,0x8349f3ba91b47b8f, 0xcb3f2f7642717713,0x241c70a936219a73,
+        0xfe0efb53d30dd4d7,0xed238cd383aa0110, 0x9ec95d1463e8a506,0xf4363804324a40aa,
+        0xc67bb4597ce2ce48,0xb143c6053edcd0d5, 0xf81aa16fdc1b81da,0xdd94b7868e94050a,
+        0x9b10a4e5e9913128,0xca7cf2b4191c8326, 0xc1d4ce1f63f57d72,0xfd1c2f611f63a3f0,
+        0xf24a01a73cf2dccf,0xbc633b39673c8cec, 0x976e41088617ca01,0xd5be0503e085d813,
+        0xbd49d14aa79dbc82,0x4b2d8644d8a74e18, 0xec9c459d51852ba2,0xddf8e7d60ed1219e,
+        0x93e1ab8252f33b45,0xcabb90e5c942b503, 0xb8da1662e7b00a17,0x3d6a751f3b936243,
+        0xe7109bfba19c0c9d,0x0cc512670a783ad4, 0x906a617d450187e2,0x27fb2b80668b24c5,
+        0xb484f9dc9641e9da,0xb1f9f660802dedf6, 0xe1a63853bbd26451,0x5e7873f8a0396973,
+        0x8d07e33455637eb2,0xdb0b487b6423e1e8, 0xb049dc016abc5e5f,0x91ce1a9a3d2cda62,
+        0xdc5c5301c56b75f7,0x7641a140cc7810fb, 0x89b9b3e11b6329ba,0xa9e904c87fcb0a9d,
+        0xac2820d9623bf429,0x546345fa9fbdcd44, 0xd732290fbacaf133,0xa97c177947ad4095,
+        0x867f59a9d4bed6c0,0x49ed8eabcccc485d, 0xa81f301449ee8c70,0x5c68f256bfff5a74,
+        0xd226fc195c6a2f8c,0x73832eec6fff3111, 0x83585d8fd9c25db7,0xc831fd53c5ff7eab,
+        0xa42e74f3d032f525,0xba3e7ca8b77f5e55, 0xcd3a1230c43fb26f,0x28ce1bd2e55f35eb,
+        0x80444b5e7aa7cf85,0x7980d163cf5b81b3, 0xa0555e361951c366,0xd7e105bcc332621f,
+        0xc86ab5c39fa63440,0x8dd9472bf3fefaa7, 0xfa856334878fc150,0xb14f98f6f0feb951,
+        0x9c935e00d4b9d8d2,0x6ed1bf9a569f33d3, 0xc3b8358109e84f07,0x0a862f80ec4700c8,
+        0xf4a642e14c6262c8,0xcd27bb612758c0fa, 0x98e7e9cccfbd7dbd,0x8038d51cb897789c,
+        0xbf21e44003acdd2c,0xe0470a63e6bd56c3, 0xeeea5d5004981478,0x1858ccfce06cac74,
+        0x95527a5202df0ccb,0x0f37801e0c43ebc8, 0xbaa718e68396cffd,0xd30560258f54e6ba,
+        0xe950df20247c83fd,0x47c6b82ef32a2069, 0x91d28b7416cdd27e,0x4cdc331d57fa5441,
+        0xb6472e511c81471d,0xe0133fe4adf8e952, 0xe3d8f9e563a198e5,0x58180fddd97723a6,
+        0x8e679c2f5e44ff8f,0x570f09eaa7ea7648,
+    };
+    static const double exactPowerOfTen[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    static inline void fullMultiply(uint64_t a, uint64_t b, uint64_t& high, uint64_t& low) {
+#if defined(__SIZEOF_INT128__)
+        unsigned __int128 r = (unsigned __int128)a * b;
+        high = (uint64_t)(r >> 64);
+        low = (uint64_t)r;
+#else
+        uint64_t aLo = (uint32_t)a, aHi = a >> 32, bLo = (uint32_t)b, bHi = b >> 32;
+        uint64_t ll = aLo * bLo, lh = aLo * bHi, hl = aHi * bLo, hh = aHi * bHi;
+        uint64_t mid = (ll >> 32) + (uint32_t)lh + (uint32_t)hl;
+        high = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+        low = (mid << 32) | (uint32_t)ll;
+#endif
+    }
+    static inline int leadingZeros64(uint64_t x) { // x != 0
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_clzll(x);
+#else
+        int n = 0;
+        while (!(x >> 63)) { x <<= 1; ++ n; }
+        return n;
+#endif
+    }
+    // w * 10^q correctly rounded, Clinger's fast path or Eisel-Lemire
+    static double decimalToDouble(uint64_t w, int64_t q, bool negative) {
+        uint64_t bits;
+#if !defined(FLT_EVAL_METHOD) || FLT_EVAL_METHOD == 0
+        if (w <= (uint64_t(1) << 53) && q >= -22 && q <= 22) {
+            // w and 10^q are exact doubles, one rounding
+            double d = (double)w;
+            d = q < 0 ? d / exactPowerOfTen[-q] : d * exactPowerOfTen[q];
+            return negative ? -d : d;
+        }
+#endif
+        if (w == 0 || q < -342) {
+            bits = 0;
+        } else if (q > 308) {
+            bits = 0x7ff0000000000000;
+        } else {
+            int lz = leadingZeros64(w);
+            w <<= lz;
+            const uint64_t* pow5 = powerOfFive128 + 2 * (q + 342);
+            uint64_t high, low;
+            fullMultiply(w, pow5[0], high, low);
+            if ((high & 0x1ff) == 0x1ff) { // the low 9 bits may carry, refine
+                uint64_t high2, low2;
+                fullMultiply(w, pow5[1], high2, low2);
+                low += high2;
+                if (high2 > low) { ++ high; }
+            }
+            int upperbit = (int)(high >> 63);
+            int shift = upperbit + 64 - 52 - 3;
+            uint64_t mantissa = high >> shift;
+            int64_t power2 = ((217706 * q) >> 16) + 63 + upperbit - lz + 1023;
+            if (power2 <= 0) { // subnormal
+                if (-power2 + 1 >= 64) {
+                    mantissa = 0;
+                    power2 = 0;
+                } else {
+                    mantissa >>= -power2 + 1;
+                    mantissa += mantissa & 1;
+                    mantissa >>= 1;
+                    power2 = mantissa < (uint64_t(1) << 52) ? 0 : 1;
+                }
+            } else {
+                // exactly halfway: round to even instead of up
+                if (low <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1
+                    && (mantissa << shift) == high) {
+                    mantissa &= ~uint64_t(1);
+                }
+                mantissa += mantissa & 1;
+                mantissa >>= 1;
+                if (mantissa >= (uint64_t(2) << 52)) {
+                    mantissa = uint64_t(1) << 52;
+                    ++ power2;
+                }
+                mantissa &= ~(uint64_t(1) << 52);
+                if (power2 >= 0x7ff) {
+                    mantissa = 0;
+                    power2 = 0x7ff;
+                }
+            }
+            bits = mantissa | ((uint64_t)power2 << 52);
+        }
+        if (negative) { bits |= uint64_t(1) << 63; }
+        double d;
+        memcpy(&d, &bits, sizeof(d));
+        return d;
+    }
+    // more than 19 significant digits that cannot be rounded from the first 19
+    static double strtodFallback(std::string num) {
+        char point = localeconv()->decimal_point[0];
+        for (char& ch : num) {
+            if (ch == '.') { ch = point; }
+        }
+        return strtod(num.c_str(), nullptr);
+    }
+    static bool isDigit(char ch) { return ch >= '0' && ch <= '9'; }
+    static bool isDigit1To9(char ch) { return ch >='1' && ch <= '9'; }
+    json::jsonError json::parseNumberRaw(parseContext& context, double& num) {
+        size_t startIdx = context.idx();
+        bool negative = false;
+        uint64_t w = 0;         // first 19 significant digits
+        int64_t q = 0;          // value is w * 10^q
+        int digits = 0;
+        bool truncated = false; // nonzero digits dropped after the 19th
+        if (context.cur() == '-') { context.curPass(); negative = true; }
+        if (context.cur() == '0') { 
+            context.curPass();
+        } else {
+            if (!isDigit1To9(context.cur())) { return JSON_PARSE_INVALID_VALUE; }
+            while (isDigit(context.cur())) {
+                char ch = context.curPass();
+                if (digits < 19) { w = w * 10 + (ch - '0'); ++ digits; }
+                else { ++ q; truncated |= ch != '0'; }
+            }
+        }
+        if (context.cur() == '.') {
+            context.curPass();
+            if (!isDigit(context.cur())) { return JSON_PARSE_INVALID_VALUE; }
+            while (isDigit(context.cur())) {
+                char ch = context.curPass();
+                if (digits < 19) {
+                    if (digits > 0 || ch != '0') { w = w * 10 + (ch - '0'); ++ digits; }
+                    -- q;
+                } else {
+                    truncated |= ch != '0';
+                }
+            }
+        }
+        if (context.cur() == 'e' || context.cur() == 'E') {
+            context.curPass();
+            bool expNegative = false;
+            if (context.cur() == '+' || context.cur() == '-') {
+                expNegative = context.curPass() == '-';
+            }
+            if (!isDigit(context.cur())) { return JSON_PARSE_INVALID_VALUE; }
+            int64_t e = 0;
+            while (isDigit(context.cur())) {
+                char ch = context.curPass();
+                if (e < 100000) { e = e * 10 + (ch - '0'); }
+            }
+            q += expNegative ? -e : e;
+        }
+        num = decimalToDouble(w, q, negative);
+        if (truncated && num != decimalToDouble(w + 1, q, negative)) {
+            num = strtodFallback(context.subUnparsed(startIdx, context.idx() - startIdx));
+        }
+        if (std::isinf(num)) {
             return JSON_PARSE_NUMBER_TOO_BIG;
         }
-        type_ = JSON_NUMBER;
         return JSON_PARSE_OK;
     }
     bool json::parseHex4(parseContext& context, unsigned& u) {
@@ -416,19 +2131,35 @@ namespace xushun {
             context.stackPushCh(0x80 | ((u      ) & 0x3f));
         }
     }
-    json::jsonError json::parseStringRaw(parseContext& context, std::string& dst) {
-        int startIdx = context.idx();
-        int startStackSize = context.stackSize();
+    json::jsonError json::parseStringRaw(parseContext& context, stringView& str) {
+        size_t startIdx = context.idx();
+        size_t startStackSize = context.stackSize();
         context.curPass(); // '\"'
         for (;;) {
+            // take the whole run of plain chars at once
+            size_t run = findSpecialChar(context.curPtr(), context.left());
+            if (run > 0) {
+                if (run < context.left() && context.curPtr()[run] == '\"'
+                    && context.stackSize() == startStackSize) {
+                    // no escapes, straight from the input
+                    str = stringView(context.curPtr(), run);
+                    context.pass(run + 1);
+                    return JSON_PARSE_OK;
+                }
+                context.stackPushStr(context.curPtr(), run);
+                context.pass(run);
+            }
+            if (context.end()) {
+                context.resetIdx(startIdx);
+                return JSON_PARSE_MISS_QUOTATION_MARK;
+            }
             char ch = context.curPass();
             switch (ch) {
                 case '\"': {
-                    int len = context.stackSize() - startStackSize;
-                    dst = context.stackPop(len);
+                    size_t len = context.stackSize() - startStackSize;
+                    str = stringView(context.stackAt(startStackSize), len);
                     return JSON_PARSE_OK;
                 }
-                case '\0': context.resetIdx(startIdx); return JSON_PARSE_MISS_QUOTATION_MARK;
                 case '\\': {
                     switch (context.curPass()) {
                         case '\"': context.stackPushCh('\"'); break;
@@ -468,149 +2199,1874 @@ namespace xushun {
                     }
                     break;
                 }
-                default: {
-                    if ((unsigned char)ch < 0x20) {
-                        context.resetIdx(startIdx);
-                        return JSON_PARSE_INVALID_STRING_CHAR;
-                    }
-                    context.stackPushCh(ch);
+                default: { // control char
+                    context.resetIdx(startIdx);
+                    return JSON_PARSE_INVALID_STRING_CHAR;
                 }
             }
         }
     }
-    json::jsonError json::parseString(parseContext& context) {
-        std::string s;
-        jsonError ret = parseStringRaw(context, s);
+    json::jsonError json::parseStringRaw(parseContext& context, std::string& dst) {
+        size_t top = context.stackSize();
+        stringView str;
+        jsonError ret = parseStringRaw(context, str);
         if (ret == JSON_PARSE_OK) {
-            setString(s);
+            dst.assign(str.data(), str.size());
         }
+        context.stackResize(top);
         return ret;
     }
-    json::jsonError json::parseArray(parseContext& context) {
-        setArray();
-        context.curPass(); // '['
-        parseWhitespace(context);
-        if (context.cur() == ']') {
-            context.curPass();
-            // setArray();
-            return JSON_PARSE_OK;
+    struct json::eventSink {
+        handler& h;
+        bool null() { return h.null(); }
+        bool boolean(bool b) { return h.boolean(b); }
+        bool number(double num) { return h.number(num); }
+        bool string(const stringView& str) { return h.string(str); }
+        bool key(const stringView& key) { return h.key(key); }
+        bool startArray() { return h.startArray(); }
+        bool endArray(size_t count) { return h.endArray(count); }
+        bool startObject() { return h.startObject(); }
+        bool endObject(size_t count) { return h.endObject(count); }
+        void abort() {}
+    };
+    // values wait on the context, as in the recursive parser before, until their container
+    // is closed; scalars are parsed straight into their slot there
+    struct json::treeSink {
+        json& root; // containers are opened in place, the root is null again after an error
+        parseContext& context;
+        arena* keys;
+        size_t elementsBase, membersBase;
+        std::vector<size_t>& frames; // the base of each open container times 2, plus 1 for an object
+        bool object = false;         // the innermost container open, false for none or an array
+        treeSink(json& r, parseContext& c) : root(r), context(c), keys(r.allocator().arena_),
+            elementsBase(c.elements().size()), membersBase(c.members().size()), frames(c.bases()) {}
+        json& slot() { // null, in the storage of the root
+            if (object) { // placed by key()
+                return context.members().back().second;
+            }
+            if (frames.empty()) {
+                return root;
+            }
+            arrayType& elements = context.elements();
+            elements.emplace_back();
+            return root.inherit(elements.back());
         }
-        jsonError ret;
-        for (;;) {
-            json elem;
-            ret = elem.parseValue(context);
-            if (ret != JSON_PARSE_OK) {
-                break;
+        bool null() {
+            slot();
+            return true;
+        }
+        bool boolean(bool b) {
+            slot().type_ = b ? JSON_TRUE : JSON_FALSE;
+            return true;
+        }
+        bool number(double num) {
+            json& v = slot();
+            v.number_ = num;
+            v.type_ = JSON_NUMBER;
+            return true;
+        }
+        bool string(const stringView& str) {
+            slot().initString(str.data(), str.size());
+            return true;
+        }
+        bool key(const stringView& key) {
+            objectType& members = context.members();
+            members.emplace_back(keyType(key.data(), key.size(), keys), json());
+            root.inherit(members.back().second);
+            return true;
+        }
+        bool startArray() {
+            slot().setArray();
+            frames.push_back(context.elements().size() * 2);
+            object = false;
+            return true;
+        }
+        bool endArray(size_t count) {
+            arrayType& elements = context.elements();
+            size_t base = frames.back() >> 1;
+            frames.pop_back();
+            json& v = opened(false, base);
+            v.array_->reserve(count);
+            for (size_t i = base; i < elements.size(); ++ i) {
+                v.array_->push_back(std::move(elements[i]));
             }
-            pushbackArray(elem);
-            parseWhitespace(context);
-            if (context.cur() == ',') {
-                context.curPass();
-                parseWhitespace(context);
-            } else if (context.cur() == ']') {
-                context.curPass();
-                // setArray();
-                return JSON_PARSE_OK;
-            } else {
-                ret = JSON_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
-                break;
+            elements.resize(base);
+            return true;
+        }
+        bool startObject() {
+            slot().setObject();
+            frames.push_back(context.members().size() * 2 + 1);
+            object = true;
+            return true;
+        }
+        bool endObject(size_t count) {
+            objectType& members = context.members();
+            size_t base = frames.back() >> 1;
+            frames.pop_back();
+            json& v = opened(true, base);
+            v.object_->reserve(count);
+            for (size_t i = base; i < members.size(); ++ i) {
+                v.object_->push_back(std::move(members[i]));
             }
+            members.resize(base);
+            v.objectFinish();
+            return true;
         }
-        setNull();
-        return ret;
-    }
-    json::jsonError json::parseObject(parseContext& context) {
-        setObject();
-        context.curPass(); // '{'
-        parseWhitespace(context);
-        if (context.cur() == '}') {
-            context.curPass();
-            // setObject();
-            return JSON_PARSE_OK;
+        // the container that opened at base, its values are still on the stack above it
+        json& opened(bool isObject, size_t base) {
+            if (frames.empty()) {
+                object = false;
+                return root;
+            }
+            objectType& members = context.members();
+            arrayType& elements = context.elements();
+            object = (frames.back() & 1) != 0;
+            if (object) {
+                return isObject ? members[base - 1].second : members.back().second;
+            }
+            return isObject ? elements.back() : elements[base - 1];
         }
-        jsonError ret;
-        for (;;) {
-            json elem;
-            elem.setNull();
+        void abort() { // the values parsed so far are dropped
+            context.elements().resize(elementsBase);
+            context.members().resize(membersBase);
+            frames.clear();
+            object = false;
+            root.setNull();
+        }
+    };
+    // one value and the whitespace after it, with the containers open so far on a stack
+    // of their own instead of the C++ stack; with Indexed, the tape from indexStructure()
+    // over the whole input skips the whitespace and the clean strings
+    template<bool Indexed, typename Sink>
+    json::jsonError json::walkValue(parseContext& context, Sink& sink, const std::vector<uint32_t>* tape) {
+        size_t next = 0; // the first tape entry not passed yet
+        auto skip = [&]() {
+            char ch = context.cur();
+            if (ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r') {
+                if (!Indexed) {
+                    do {
+                        context.pass(1);
+                        ch = context.cur();
+                    } while (ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r');
+                    return;
+                }
+                size_t pos = context.idx();
+                while (next < tape->size() && ((*tape)[next] & TAPE_POSITION) < pos) {
+                    ++ next;
+                }
+                context.resetIdx(next < tape->size() ? ((*tape)[next] & TAPE_POSITION) : pos + context.left());
+            }
+        };
+        auto readString = [&](bool isKey) -> jsonError {
+            if (Indexed) {
+                size_t pos = context.idx();
+                while (next < tape->size() && ((*tape)[next] & TAPE_POSITION) < pos) {
+                    ++ next;
+                }
+                // the closing quote follows the opening one on the tape, a clean string is taken as it is
+                if (next + 1 < tape->size() && (*tape)[next] == pos && ((*tape)[next + 1] & TAPE_DECODE) == 0) {
+                    size_t close = (*tape)[next + 1];
+                    stringView str(context.curPtr() + 1, close - pos - 1);
+                    next += 2;
+                    context.resetIdx(close + 1);
+                    return (isKey ? sink.key(str) : sink.string(str)) ? JSON_PARSE_OK : JSON_PARSE_TERMINATED;
+                }
+            }
+            size_t top = context.stackSize();
+            stringView str;
+            jsonError ret = parseStringRaw(context, str);
+            if (ret == JSON_PARSE_OK && !(isKey ? sink.key(str) : sink.string(str))) {
+                ret = JSON_PARSE_TERMINATED;
+            }
+            context.stackResize(top);
+            return ret;
+        };
+        auto readKey = [&]() -> jsonError {
             if (context.cur() != '\"') {
-                ret = JSON_PARSE_MISS_KEY;
-                break;
+                return JSON_PARSE_MISS_KEY;
             }
-            std::string key;
-            ret = parseStringRaw(context, key);
+            jsonError ret = readString(true);
             if (ret != JSON_PARSE_OK) {
-                // 
-                break;
+                return ret;
             }
-            parseWhitespace(context);
+            skip();
             if (context.cur() != ':') {
-                ret = JSON_PARSE_MISS_COLON;
-                break;
+                return JSON_PARSE_MISS_COLON;
+            }
+            context.pass(1);
+            skip();
+            return JSON_PARSE_OK;
+        };
+        // open containers, the count of values times 2 plus 1 for an object
+        std::vector<size_t>& stack = context.levels();
+        stack.clear();
+        size_t maxDepth = getMaxDepth();
+        maxDepth = maxDepth > context.outer() ? maxDepth - context.outer() : 0;
+        jsonError ret;
+        bool go = true;
+        skip();
+        for (;;) {
+            // a value
+            switch (context.cur()) {
+                case '[':
+                    if (stack.size() >= maxDepth) { ret = JSON_PARSE_DEPTH_EXCEEDED; break; }
+                    if (!sink.startArray()) { ret = JSON_PARSE_TERMINATED; break; }
+                    context.pass(1);
+                    skip();
+                    if (context.cur() == ']') {
+                        context.pass(1);
+                        go = sink.endArray(0);
+                        ret = JSON_PARSE_OK;
+                        break;
+                    }
+                    stack.push_back(0);
+                    continue;
+                case '{':
+                    if (stack.size() >= maxDepth) { ret = JSON_PARSE_DEPTH_EXCEEDED; break; }
+                    if (!sink.startObject()) { ret = JSON_PARSE_TERMINATED; break; }
+                    context.pass(1);
+                    skip();
+                    if (context.cur() == '}') {
+                        context.pass(1);
+                        go = sink.endObject(0);
+                        ret = JSON_PARSE_OK;
+                        break;
+                    }
+                    stack.push_back(1);
+                    ret = readKey();
+                    if (ret != JSON_PARSE_OK) { break; }
+                    continue;
+                case '\"':
+                    ret = readString(false);
+                    break;
+                case 'n':
+                    ret = parseLiteralRaw(context, "null");
+                    if (ret == JSON_PARSE_OK) { go = sink.null(); }
+                    break;
+                case 't':
+                    ret = parseLiteralRaw(context, "true");
+                    if (ret == JSON_PARSE_OK) { go = sink.boolean(true); }
+                    break;
+                case 'f':
+                    ret = parseLiteralRaw(context, "false");
+                    if (ret == JSON_PARSE_OK) { go = sink.boolean(false); }
+                    break;
+                default: {
+                    if (context.end()) { ret = JSON_PARSE_EXPECT_VALUE; break; }
+                    double num;
+                    ret = parseNumberRaw(context, num);
+                    if (ret == JSON_PARSE_OK) { go = sink.number(num); }
+                }
+            }
+            if (!go) {
+                ret = JSON_PARSE_TERMINATED;
+            }
+            // after a value: close containers until a ',' asks for the next one
+            while (ret == JSON_PARSE_OK) {
+                skip();
+                if (stack.empty()) {
+                    return JSON_PARSE_OK;
+                }
+                bool object = (stack.back() & 1) != 0;
+                stack.back() += 2;
+                char ch = context.cur();
+                if (ch == ',') {
+                    context.pass(1);
+                    skip();
+                    if (object) {
+                        ret = readKey();
+                    }
+                    break;
+                }
+                if (ch != (object ? '}' : ']')) {
+                    ret = object ? JSON_PARSE_MISS_COMMA_OR_CURLY_BRACKET : JSON_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
+                    break;
+                }
+                context.pass(1);
+                size_t count = stack.back() >> 1;
+                stack.pop_back();
+                if (!(object ? sink.endObject(count) : sink.endArray(count))) {
+                    ret = JSON_PARSE_TERMINATED;
+                }
             }
-            context.curPass();
-            parseWhitespace(context);
-            ret = elem.parseValue(context);
             if (ret != JSON_PARSE_OK) {
-                break;
+                sink.abort();
+                return ret;
+            }
+        }
+    }
+    json::jsonError json::parseValue(parseContext& context) { // this must be null
+        treeSink sink(*this, context);
+        return walkValue<false>(context, sink, nullptr);
+    }
+    json::jsonError json::parse(const std::string& jsonString) {
+        return parse(jsonString.data(), jsonString.size());
+    }
+    json::jsonError json::parse(const char* jsonString) {
+        return parse(jsonString, strlen(jsonString));
+    }
+    json::jsonError json::parse(const stringView& jsonString) {
+        return parse(jsonString.data(), jsonString.size());
+    }
+    json::jsonError json::parse(const char* data, size_t len) {
+        parseContext context(data, len);
+        return parseRoot(context);
+    }
+    json::jsonError json::parseRoot(parseContext& context) {
+        setNull();
+        jsonError ret = parseValue(context);
+        if (ret == JSON_PARSE_OK && !context.end()) {
+            setNull();
+            return JSON_PARSE_ROOT_NOT_SINGULAR;
+        }
+        return ret;
+    }
+
+
+
+    // sax
+    json::jsonError json::parseEventString(parseContext& context, handler& h, bool isKey) {
+        size_t top = context.stackSize();
+        stringView str;
+        jsonError ret = parseStringRaw(context, str);
+        if (ret == JSON_PARSE_OK && !(isKey ? h.key(str) : h.string(str))) {
+            ret = JSON_PARSE_TERMINATED;
+        }
+        context.stackResize(top);
+        return ret;
+    }
+    json::jsonError json::parseEventValue(parseContext& context, handler& h) {
+        eventSink sink{h};
+        return walkValue<false>(context, sink, nullptr);
+    }
+    json::jsonError json::parse(const stringView& jsonString, handler& h) {
+        return parse(jsonString.data(), jsonString.size(), h);
+    }
+    json::jsonError json::parse(const char* data, size_t len, handler& h) {
+        parseContext context(data, len);
+        return parseEventRoot(context, h);
+    }
+    json::jsonError json::parseEventRoot(parseContext& context, handler& h) {
+        jsonError ret = parseEventValue(context, h);
+        if (ret == JSON_PARSE_OK && !context.end()) {
+            return JSON_PARSE_ROOT_NOT_SINGULAR;
+        }
+        return ret;
+    }
+    json::jsonError json::parser::parse(json& value, const char* data, size_t len) {
+        parseContext context(data, len, this);
+        return value.parseRoot(context);
+    }
+    json::jsonError json::parser::parse(json& value, const stringView& text) {
+        return parse(value, text.data(), text.size());
+    }
+    json::jsonError json::parser::parse(const char* data, size_t len, handler& h) {
+        parseContext context(data, len, this);
+        return parseEventRoot(context, h);
+    }
+
+
+
+
+    // structural index
+    const char* json::indexEngine() {
+        return selectIndexEngine().name;
+    }
+    json::jsonError json::parseIndexed(const std::string& jsonString) {
+        return parseIndexed(jsonString.data(), jsonString.size());
+    }
+    json::jsonError json::parseIndexed(const char* jsonString) {
+        return parseIndexed(jsonString, strlen(jsonString));
+    }
+    json::jsonError json::parseIndexed(const stringView& jsonString) {
+        return parseIndexed(jsonString.data(), jsonString.size());
+    }
+    json::jsonError json::parseIndexed(const char* data, size_t len) {
+        setNull();
+        if (len > TAPE_POSITION) {
+            return parse(data, len);
+        }
+        parseContext context(data, len);
+        std::vector<uint32_t> tape;
+        indexStructure(data, len, tape);
+        treeSink sink(*this, context);
+        jsonError ret = walkValue<true>(context, sink, &tape);
+        if (ret == JSON_PARSE_OK && !context.end()) {
+            setNull();
+            return JSON_PARSE_ROOT_NOT_SINGULAR;
+        }
+        return ret;
+    }
+    json::jsonError json::parseIndexed(const char* data, size_t len, handler& h) {
+        if (len > TAPE_POSITION) {
+            return parse(data, len, h);
+        }
+        parseContext context(data, len);
+        std::vector<uint32_t> tape;
+        indexStructure(data, len, tape);
+        eventSink sink{h};
+        jsonError ret = walkValue<true>(context, sink, &tape);
+        if (ret == JSON_PARSE_OK && !context.end()) {
+            return JSON_PARSE_ROOT_NOT_SINGULAR;
+        }
+        return ret;
+    }
+
+
+
+
+    // stream
+    void json::builder::reset() {
+        stack_.clear();
+    }
+    json& json::builder::place() {
+        if (stack_.empty()) {
+            return *root_;
+        }
+        json* top = stack_.back();
+        if (top->type_ == JSON_ARRAY) {
+            return top->emplacebackArray();
+        }
+        return top->objectAppend(key_.data(), key_.size());
+    }
+    bool json::builder::null() {
+        place().setNull();
+        return true;
+    }
+    bool json::builder::boolean(bool b) {
+        place().setBoolean(b);
+        return true;
+    }
+    bool json::builder::number(double num) {
+        place().setNumber(num);
+        return true;
+    }
+    bool json::builder::string(const stringView& str) {
+        place().setStringRaw(str.data(), str.size());
+        return true;
+    }
+    bool json::builder::key(const stringView& key) {
+        key_.assign(key.data(), key.size());
+        return true;
+    }
+    bool json::builder::startObject() {
+        json& slot = place();
+        slot.setObject();
+        stack_.push_back(&slot);
+        return true;
+    }
+    bool json::builder::endObject(size_t /*memberCount*/) {
+        stack_.back()->objectFinish();
+        stack_.pop_back();
+        return true;
+    }
+    bool json::builder::startArray() {
+        json& slot = place();
+        slot.setArray();
+        stack_.push_back(&slot);
+        return true;
+    }
+    bool json::builder::endArray(size_t /*elementCount*/) {
+        stack_.pop_back();
+        return true;
+    }
+    json::streamParser::streamParser(handler& h) : builder_(nullptr), handler_(&h), result_(nullptr) {
+        reset();
+    }
+    json::streamParser::streamParser(json& result) : builder_(&result), handler_(&builder_), result_(&result) {
+        reset();
+    }
+    void json::streamParser::reset() {
+        builder_.reset();
+        if (result_ != nullptr) {
+            result_->setNull();
+        }
+        state_ = VALUE;
+        stack_.clear();
+        carry_.clear();
+        carryString_ = false;
+        escape_ = false;
+        finished_ = false;
+        error_ = JSON_PARSE_OK;
+    }
+    // end of a string token: one past the closing quote or the first control char,
+    // npos if more input is needed
+    size_t json::streamParser::scanString(const char* p, size_t len, bool& escape) {
+        size_t i = 0;
+        if (escape) {
+            if (len == 0) {
+                return std::string::npos;
+            }
+            escape = false;
+            ++ i;
+        }
+        while (i < len) {
+            i += findSpecialChar(p + i, len - i);
+            if (i == len) {
+                break;
+            }
+            if (p[i] != '\\') {
+                return i + 1;
+            }
+            if (i + 1 == len) {
+                escape = true;
+                break;
+            }
+            i += 2;
+        }
+        return std::string::npos;
+    }
+    // end of a literal or number token: the first delimiter, npos if more input is needed
+    size_t json::streamParser::scanRun(const char* p, size_t len) {
+        for (size_t i = 0; i < len; ++ i) {
+            switch (p[i]) {
+                case ' ': case '\t': case '\n': case '\r':
+                case ',': case ':': case '[': case ']': case '{': case '}': case '\"':
+                    return i;
+            }
+        }
+        return std::string::npos;
+    }
+    bool json::streamParser::tokenComplete(parseContext& context) {
+        const char* p = context.curPtr();
+        size_t len = context.left();
+        carryString_ = *p == '\"';
+        escape_ = false;
+        if (carryString_) {
+            return scanString(p + 1, len - 1, escape_) != std::string::npos;
+        }
+        return scanRun(p, len) != std::string::npos;
+    }
+    void json::streamParser::valueDone() {
+        if (stack_.empty()) {
+            state_ = AFTER_ROOT;
+        } else {
+            ++ stack_.back().count;
+            state_ = AFTER_VALUE;
+        }
+    }
+    json::jsonError json::streamParser::closeContainer() {
+        frame top = stack_.back();
+        stack_.pop_back();
+        if (!(top.isObject ? handler_->endObject(top.count) : handler_->endArray(top.count))) {
+            return JSON_PARSE_TERMINATED;
+        }
+        valueDone();
+        return JSON_PARSE_OK;
+    }
+    // the grammar of parseValue, parseArray and parseObject as a state machine,
+    // stops in front of a token cut by the end of data
+    json::jsonError json::streamParser::run(const char* data, size_t len, size_t& used) {
+        parseContext context(data, len);
+        for (;;) {
+            parseWhitespace(context);
+            used = context.idx();
+            if (context.end() && !finished_) {
+                return JSON_PARSE_OK;
+            }
+            char ch = context.cur();
+            jsonError ret = JSON_PARSE_OK;
+            switch (state_) {
+                case AFTER_ROOT:
+                    return context.end() ? JSON_PARSE_OK : JSON_PARSE_ROOT_NOT_SINGULAR;
+                case AFTER_VALUE:
+                    if (ch == ',') {
+                        context.curPass();
+                        state_ = stack_.back().isObject ? KEY : VALUE;
+                    } else if (ch == (stack_.back().isObject ? '}' : ']')) {
+                        context.curPass();
+                        ret = closeContainer();
+                    } else {
+                        return stack_.back().isObject ? JSON_PARSE_MISS_COMMA_OR_CURLY_BRACKET : JSON_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
+                    }
+                    break;
+                case COLON:
+                    if (ch != ':') {
+                        return JSON_PARSE_MISS_COLON;
+                    }
+                    context.curPass();
+                    state_ = VALUE;
+                    break;
+                case OBJECT_FIRST:
+                    if (ch == '}') {
+                        context.curPass();
+                        ret = closeContainer();
+                        break;
+                    }
+                    // fall through
+                case KEY:
+                    if (ch != '\"') {
+                        return JSON_PARSE_MISS_KEY;
+                    }
+                    if (!finished_ && !tokenComplete(context)) {
+                        return JSON_PARSE_OK;
+                    }
+                    ret = parseEventString(context, *handler_, true);
+                    state_ = COLON;
+                    break;
+                case ARRAY_FIRST:
+                    if (ch == ']') {
+                        context.curPass();
+                        ret = closeContainer();
+                        break;
+                    }
+                    // fall through
+                case VALUE:
+                    if (ch == '[' || ch == '{') {
+                        bool isObject = ch == '{';
+                        if (stack_.size() >= getMaxDepth()) {
+                            return JSON_PARSE_DEPTH_EXCEEDED;
+                        }
+                        context.curPass();
+                        if (!(isObject ? handler_->startObject() : handler_->startArray())) {
+                            return JSON_PARSE_TERMINATED;
+                        }
+                        stack_.push_back(frame{isObject, 0});
+                        state_ = isObject ? OBJECT_FIRST : ARRAY_FIRST;
+                        break;
+                    }
+                    if (!finished_ && !tokenComplete(context)) {
+                        return JSON_PARSE_OK;
+                    }
+                    ret = parseEventValue(context, *handler_);
+                    if (ret == JSON_PARSE_OK) {
+                        valueDone();
+                    }
+                    break;
+            }
+            if (ret != JSON_PARSE_OK) {
+                return ret;
+            }
+        }
+    }
+    json::jsonError json::streamParser::fail(jsonError err) {
+        error_ = err;
+        carry_.clear();
+        if (result_ != nullptr) {
+            builder_.reset();
+            result_->setNull();
+        }
+        return err;
+    }
+    json::jsonError json::streamParser::feed(const stringView& chunk) {
+        return feed(chunk.data(), chunk.size());
+    }
+    json::jsonError json::streamParser::feed(const char* data, size_t len) {
+        if (error_ != JSON_PARSE_OK) {
+            return error_;
+        }
+        size_t used;
+        jsonError ret;
+        // complete the carried token with as few bytes of the chunk as possible,
+        // the rest is parsed in place
+        while (!carry_.empty() && len > 0) {
+            size_t take = carryString_ ? scanString(data, len, escape_) : scanRun(data, len);
+            if (take == std::string::npos) {
+                carry_.append(data, len);
+                return JSON_PARSE_OK;
+            }
+            if (!carryString_) {
+                ++ take; // the delimiter, so that the token is seen complete
+            }
+            carry_.append(data, take);
+            data += take;
+            len -= take;
+            ret = run(carry_.data(), carry_.size(), used);
+            if (ret != JSON_PARSE_OK) {
+                return fail(ret);
+            }
+            carry_.erase(0, used);
+        }
+        if (len == 0) {
+            return JSON_PARSE_OK;
+        }
+        ret = run(data, len, used);
+        if (ret != JSON_PARSE_OK) {
+            return fail(ret);
+        }
+        carry_.assign(data + used, len - used);
+        return JSON_PARSE_OK;
+    }
+    json::jsonError json::streamParser::finish() {
+        if (error_ != JSON_PARSE_OK) {
+            return error_;
+        }
+        finished_ = true;
+        size_t used;
+        jsonError ret = run(carry_.data(), carry_.size(), used);
+        carry_.clear();
+        if (ret != JSON_PARSE_OK) {
+            return fail(ret);
+        }
+        return JSON_PARSE_OK;
+    }
+
+
+
+
+    // file
+    bool json::mappedFile::open(const std::string& path) {
+        close();
+#if defined(__unix__) || defined(__APPLE__)
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            ::close(fd);
+            return false;
+        }
+        if (S_ISREG(st.st_mode)) {
+            size_ = st.st_size;
+            if (size_ == 0) {
+                ::close(fd);
+                data_ = "";
+                return true;
+            }
+            void* p = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (p == MAP_FAILED) {
+                size_ = 0;
+                return false;
+            }
+            madvise(p, size_, MADV_SEQUENTIAL);
+            data_ = (const char*)p;
+            mapped_ = true;
+            return true;
+        }
+        // pipes, FIFOs, terminals and /proc files have no size to map, they are read to the end
+        FILE* file = fdopen(fd, "rb");
+        if (file == nullptr) {
+            ::close(fd);
+            return false;
+        }
+#else
+        FILE* file = fopen(path.c_str(), "rb");
+        if (file == nullptr) {
+            return false;
+        }
+#endif
+        char buf[65536];
+        size_t n;
+        while ((n = fread(buf, 1, sizeof(buf), file)) > 0) {
+            buffer_.append(buf, n);
+        }
+        bool ok = ferror(file) == 0;
+        fclose(file);
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+        return ok;
+    }
+    void json::mappedFile::close() {
+#if defined(__unix__) || defined(__APPLE__)
+        if (mapped_) {
+            munmap((void*)data_, size_);
+        }
+#endif
+        buffer_.clear();
+        data_ = nullptr;
+        size_ = 0;
+        mapped_ = false;
+    }
+    json::jsonError json::parseFile(const std::string& path) {
+        mappedFile file;
+        if (!file.open(path)) {
+            setNull();
+            return JSON_PARSE_FILE_ERROR;
+        }
+        return parse(file.data(), file.size());
+    }
+
+
+
+
+    // json lines
+    json::lineReader::lineReader() : data_(nullptr), len_(0), pos_(0), line_(0), error_(JSON_PARSE_OK) {}
+    json::lineReader::lineReader(const char* data, size_t len) : data_(data), len_(len), pos_(0), line_(0), error_(JSON_PARSE_OK) {}
+    json::lineReader::lineReader(const stringView& buffer) : lineReader(buffer.data(), buffer.size()) {}
+    bool json::lineReader::open(const std::string& path) {
+        bool ok = file_.open(path);
+        data_ = file_.data();
+        len_ = file_.size();
+        pos_ = 0;
+        line_ = 0;
+        error_ = ok ? JSON_PARSE_OK : JSON_PARSE_FILE_ERROR;
+        return ok;
+    }
+    bool json::lineReader::next(json& record) {
+        while (error_ == JSON_PARSE_OK && pos_ < len_) {
+            const char* begin = data_ + pos_;
+            const char* end = (const char*)memchr(begin, '\n', len_ - pos_);
+            size_t lineLen = end == nullptr ? len_ - pos_ : end - begin;
+            pos_ += lineLen + 1;
+            ++ line_;
+            size_t i = 0;
+            while (i < lineLen && (begin[i] == ' ' || begin[i] == '\t' || begin[i] == '\r')) {
+                ++ i;
+            }
+            if (i == lineLen) {
+                continue;
+            }
+            // parsed in place, the line is not copied
+            error_ = record.parse(begin, lineLen);
+            return error_ == JSON_PARSE_OK;
+        }
+        return false;
+    }
+    json::jsonError json::lineReader::error() {
+        return error_;
+    }
+    size_t json::lineReader::line() {
+        return line_;
+    }
+    json::lineWriter::lineWriter(std::string& out) : out_(&out), file_(nullptr) {}
+    json::lineWriter::lineWriter(FILE* file) : out_(nullptr), file_(file) {}
+    json::lineWriter::~lineWriter() {
+        flush();
+    }
+    void json::lineWriter::write(json& record) {
+        std::string& out = out_ != nullptr ? *out_ : buffer_;
+        record.dumpValue(out);
+        out.push_back('\n');
+        if (buffer_.size() >= 65536) {
+            flush();
+        }
+    }
+    void json::lineWriter::flush() {
+        if (file_ != nullptr && !buffer_.empty()) {
+            fwrite(buffer_.data(), 1, buffer_.size(), file_);
+            buffer_.clear();
+        }
+    }
+    json::jsonError json::parseLinesRaw(const char* data, size_t len, std::vector<json>& records, size_t& lines) {
+        lineReader reader(data, len);
+        records.emplace_back();
+        while (reader.next(records.back())) {
+            records.emplace_back();
+        }
+        records.pop_back();
+        lines = reader.line();
+        return reader.error();
+    }
+    json::jsonError json::parseLines(const stringView& buffer, std::vector<json>& records, size_t& errorLine, unsigned threads) {
+        return parseLines(buffer.data(), buffer.size(), records, errorLine, threads);
+    }
+    json::jsonError json::parseLines(const char* data, size_t len, std::vector<json>& records, size_t& errorLine, unsigned threads) {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        // cut into about equal parts, every cut just after a newline
+        std::vector<size_t> cuts(1, 0);
+        for (unsigned k = 1; k < threads; ++ k) {
+            size_t cut = std::max(cuts.back(), len / threads * k);
+            const char* nl = cut < len ? (const char*)memchr(data + cut, '\n', len - cut) : nullptr;
+            if (nl == nullptr) {
+                break;
+            }
+            cuts.push_back(nl - data + 1);
+        }
+        cuts.push_back(len);
+        size_t parts = cuts.size() - 1;
+        std::vector<std::vector<json>> partRecords(parts);
+        std::vector<size_t> partLines(parts);
+        std::vector<jsonError> partErrors(parts);
+        std::vector<std::thread> workers;
+        for (size_t k = 1; k < parts; ++ k) {
+            workers.emplace_back([&, k]() {
+                partErrors[k] = parseLinesRaw(data + cuts[k], cuts[k + 1] - cuts[k], partRecords[k], partLines[k]);
+            });
+        }
+        partErrors[0] = parseLinesRaw(data, cuts[1], partRecords[0], partLines[0]);
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        // the first part with an error holds the first error
+        size_t last = 0, total = partRecords[0].size();
+        errorLine = partLines[0];
+        while (partErrors[last] == JSON_PARSE_OK && last + 1 < parts) {
+            ++ last;
+            total += partRecords[last].size();
+            errorLine += partLines[last];
+        }
+        records.clear();
+        records.reserve(total);
+        for (size_t k = 0; k <= last; ++ k) {
+            for (json& record : partRecords[k]) {
+                records.push_back(std::move(record));
+            }
+        }
+        if (partErrors[last] == JSON_PARSE_OK) {
+            errorLine = 0;
+        }
+        return partErrors[last];
+    }
+    // the elements of a part, the commas between them, and no more
+    json::jsonError json::parseElements(const char* data, size_t len, std::vector<json>& elements) {
+        parseContext context(data, len);
+        context.outer() = 1;
+        for (;;) {
+            elements.emplace_back();
+            jsonError ret = inherit(elements.back()).parseValue(context);
+            if (ret != JSON_PARSE_OK) {
+                return ret;
+            }
+            if (context.end()) {
+                return JSON_PARSE_OK;
+            }
+            if (context.cur() != ',') {
+                return JSON_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
+            }
+            context.pass(1);
+        }
+    }
+    json::jsonError json::parseParallel(const char* data, size_t len, unsigned threads) {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        size_t parts = std::min((size_t)threads, len / PARALLEL_PART_MIN);
+        size_t start = skipValidWhitespace(data, len, 0);
+        if (parts < 2 || arena_ != 0 || start == len || data[start] != '[' || getMaxDepth() == 0) {
+            return parse(data, len);
+        }
+        // about equal parts, between elements of the array only
+        std::vector<size_t> targets, cuts;
+        for (size_t k = 1; k < parts; ++ k) {
+            targets.push_back(len / parts * k);
+        }
+        cuts.push_back(start);
+        size_t close = findElementCuts(data, len, start, targets, cuts);
+        if (close == len || data[close] != ']' || skipValidWhitespace(data, len, close + 1) != len || cuts.size() < 2) {
+            return parse(data, len);
+        }
+        cuts.push_back(close);
+        parts = cuts.size() - 1;
+        setNull();
+        std::vector<std::vector<json>> partElements(parts);
+        std::vector<jsonError> partErrors(parts);
+        std::vector<std::thread> workers;
+        for (size_t k = 1; k < parts; ++ k) {
+            workers.emplace_back([&, k]() {
+                partErrors[k] = parseElements(data + cuts[k] + 1, cuts[k + 1] - cuts[k] - 1, partElements[k]);
+            });
+        }
+        partErrors[0] = parseElements(data + cuts[0] + 1, cuts[1] - cuts[0] - 1, partElements[0]);
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        size_t total = 0;
+        for (size_t k = 0; k < parts; ++ k) {
+            if (partErrors[k] != JSON_PARSE_OK) {
+                return parse(data, len);
+            }
+            total += partElements[k].size();
+        }
+        setArray();
+        array_->reserve(total);
+        for (std::vector<json>& elements : partElements) {
+            for (json& elem : elements) {
+                array_->push_back(std::move(elem));
+            }
+        }
+        return JSON_PARSE_OK;
+    }
+    json::jsonError json::parseParallel(const stringView& text, unsigned threads) {
+        return parseParallel(text.data(), text.size(), threads);
+    }
+
+
+
+
+
+
+
+
+
+
+    // on demand
+    // the text has passed parse() already, only its structure is followed
+    size_t json::skipValidWhitespace(const char* data, size_t len, size_t pos) {
+        while (pos < len && (data[pos] == ' ' || data[pos] == '\t' || data[pos] == '\n' || data[pos] == '\r')) {
+            ++ pos;
+        }
+        return pos;
+    }
+    size_t json::skipValidString(const char* data, size_t len, size_t pos) { // one past the closing quote
+        ++ pos; // '\"'
+        for (;;) {
+            pos += findSpecialChar(data + pos, len - pos);
+            if (data[pos] != '\\') {
+                return pos + 1;
+            }
+            pos += 2;
+        }
+    }
+    size_t json::skipValidValue(const char* data, size_t len, size_t pos) {
+        char ch = data[pos];
+        if (ch == '\"') {
+            return skipValidString(data, len, pos);
+        }
+        if (ch != '[' && ch != '{') {
+            while (pos < len && data[pos] != ',' && data[pos] != ']' && data[pos] != '}'
+                && data[pos] != ' ' && data[pos] != '\t' && data[pos] != '\n' && data[pos] != '\r') {
+                ++ pos;
+            }
+            return pos;
+        }
+        size_t depth = 0;
+        while (pos < len) {
+            ch = data[pos];
+            if (ch == '\"') {
+                pos = skipValidString(data, len, pos);
+                continue;
+            }
+            if (ch == '[' || ch == '{') {
+                ++ depth;
+            } else if ((ch == ']' || ch == '}') && -- depth == 0) {
+                return pos + 1;
+            }
+            ++ pos;
+        }
+        return pos;
+    }
+    json::lazyValue::lazyValue() : data_(nullptr), len_(0), pos_(std::string::npos), error_(JSON_PARSE_EXPECT_VALUE) {}
+    json::lazyValue::lazyValue(const char* data, size_t len, size_t pos) : data_(data), len_(len), pos_(pos), error_(JSON_PARSE_OK) {}
+    json::jsonError json::lazyValue::parse(const char* data, size_t len) {
+        // every callback of the base handler goes on
+        handler check;
+        data_ = data;
+        len_ = len;
+        error_ = json::parse(data, len, check);
+        pos_ = error_ == JSON_PARSE_OK ? skipValidWhitespace(data, len, 0) : std::string::npos;
+        return error_;
+    }
+    json::jsonError json::lazyValue::parse(const stringView& buffer) {
+        return parse(buffer.data(), buffer.size());
+    }
+    json::jsonError json::lazyValue::error() {
+        return error_;
+    }
+    bool json::lazyValue::exists() {
+        return pos_ != std::string::npos;
+    }
+    json::jsonType json::lazyValue::getType() {
+        if (!exists()) {
+            return JSON_NULL;
+        }
+        switch (data_[pos_]) {
+            case 'n':  return JSON_NULL;
+            case 't':  return JSON_TRUE;
+            case 'f':  return JSON_FALSE;
+            case '\"': return JSON_STRING;
+            case '[':  return JSON_ARRAY;
+            case '{':  return JSON_OBJECT;
+            default:   return JSON_NUMBER;
+        }
+    }
+    bool json::lazyValue::getBoolean() {
+        return getType() == JSON_TRUE;
+    }
+    double json::lazyValue::getNumber() {
+        if (getType() != JSON_NUMBER) {
+            return 0.0;
+        }
+        parseContext context(data_, len_);
+        context.resetIdx(pos_);
+        double num = 0.0;
+        parseNumberRaw(context, num);
+        return num;
+    }
+    std::string json::lazyValue::getString() {
+        std::string str;
+        if (getType() == JSON_STRING) {
+            parseContext context(data_, len_);
+            context.resetIdx(pos_);
+            parseStringRaw(context, str);
+        }
+        return str;
+    }
+    size_t json::lazyValue::next(size_t pos, char close) {
+        pos = skipValidWhitespace(data_, len_, skipValidValue(data_, len_, pos));
+        if (data_[pos] == close) {
+            return std::string::npos;
+        }
+        return skipValidWhitespace(data_, len_, pos + 1); // ','
+    }
+    size_t json::lazyValue::getArraySize() {
+        if (getType() != JSON_ARRAY) {
+            return 0;
+        }
+        size_t count = 0;
+        size_t pos = skipValidWhitespace(data_, len_, pos_ + 1);
+        for (; pos != std::string::npos && data_[pos] != ']'; ++ count) {
+            pos = next(pos, ']');
+        }
+        return count;
+    }
+    size_t json::lazyValue::getObjectSize() {
+        if (getType() != JSON_OBJECT) {
+            return 0;
+        }
+        // members are counted as they are scanned, the keys are kept as spans of the text;
+        // only keys with escapes are decoded, once all are known
+        std::vector<stringView> keys;
+        std::vector<size_t> escaped;
+        size_t pos = skipValidWhitespace(data_, len_, pos_ + 1);
+        while (pos != std::string::npos && data_[pos] != '}') {
+            size_t end = skipValidString(data_, len_, pos);
+            if (memchr(data_ + pos, '\\', end - pos) != nullptr) {
+                escaped.push_back(keys.size());
+            }
+            keys.push_back(stringView(data_ + pos + 1, end - pos - 2));
+            pos = next(skipValidWhitespace(data_, len_, skipValidWhitespace(data_, len_, end) + 1), '}');
+        }
+        if (keys.size() < 2) {
+            return keys.size();
+        }
+        // repeated keys count once, as in parse(): sort the spans and drop equal neighbours
+        std::vector<std::string> decoded(escaped.size());
+        for (size_t k = 0; k < escaped.size(); ++ k) {
+            stringView& key = keys[escaped[k]];
+            parseContext context(data_, len_);
+            context.resetIdx(key.data() - 1 - data_);
+            parseStringRaw(context, decoded[k]);
+            key = stringView(decoded[k]);
+        }
+        std::sort(keys.begin(), keys.end(), [](const stringView& a, const stringView& b) {
+            int cmp = memcmp(a.data(), b.data(), std::min(a.size(), b.size()));
+            return cmp != 0 ? cmp < 0 : a.size() < b.size();
+        });
+        return std::unique(keys.begin(), keys.end()) - keys.begin();
+    }
+    json::lazyValue json::lazyValue::operator[](size_t index) {
+        lazyValue found(data_, len_, std::string::npos);
+        found.error_ = error_;
+        if (getType() != JSON_ARRAY) {
+            return found;
+        }
+        size_t pos = skipValidWhitespace(data_, len_, pos_ + 1);
+        for (size_t i = 0; pos != std::string::npos && data_[pos] != ']'; ++ i) {
+            if (i == index) {
+                found.pos_ = pos;
+                break;
+            }
+            pos = next(pos, ']');
+        }
+        return found;
+    }
+    // the first member with the key, as in parse()
+    json::lazyValue json::lazyValue::member(const char* key, size_t len) {
+        lazyValue found(data_, len_, std::string::npos);
+        found.error_ = error_;
+        if (getType() != JSON_OBJECT) {
+            return found;
+        }
+        size_t pos = skipValidWhitespace(data_, len_, pos_ + 1);
+        while (pos != std::string::npos && data_[pos] != '}') {
+            size_t end = skipValidString(data_, len_, pos);
+            bool match;
+            if (memchr(data_ + pos, '\\', end - pos) == nullptr) {
+                match = end - pos - 2 == len && memcmp(data_ + pos + 1, key, len) == 0;
+            } else {
+                // escapes are decoded for the comparison only
+                parseContext context(data_, len_);
+                context.resetIdx(pos);
+                stringView str;
+                parseStringRaw(context, str);
+                match = str == stringView(key, len);
+            }
+            size_t value = skipValidWhitespace(data_, len_, skipValidWhitespace(data_, len_, end) + 1); // ':'
+            if (match) {
+                found.pos_ = value;
+                break;
+            }
+            pos = next(value, '}');
+        }
+        return found;
+    }
+    json::lazyValue json::lazyValue::operator[](const std::string& key) {
+        return member(key.data(), key.size());
+    }
+    template<typename T>
+    json::lazyValue json::lazyValue::operator[](T* key) {
+        return member(key, strlen(key));
+    }
+    bool json::lazyValue::existObjectElement(const std::string& key) {
+        return member(key.data(), key.size()).exists();
+    }
+    stringView json::lazyValue::raw() {
+        if (!exists()) {
+            return stringView();
+        }
+        return stringView(data_ + pos_, skipValidValue(data_, len_, pos_) - pos_);
+    }
+    json::jsonError json::lazyValue::get(json& out) {
+        out.setNull();
+        if (!exists()) {
+            return error_ == JSON_PARSE_OK ? JSON_PARSE_EXPECT_VALUE : error_;
+        }
+        parseContext context(data_, len_);
+        context.resetIdx(pos_);
+        return out.parseValue(context);
+    }
+    json::lazyValue json::lazyValue::find(const pointer& at) {
+        lazyValue found = *this;
+        if (!at.valid_) {
+            found.pos_ = std::string::npos;
+        }
+        for (size_t i = 0; i < at.steps_.size() && found.exists(); ++ i) {
+            const pointer::step& step = at.steps_[i];
+            if (found.getType() == JSON_OBJECT) {
+                found = found.member(step.key.data(), step.key.size());
+            } else if (found.getType() == JSON_ARRAY && step.index != std::string::npos) {
+                found = found[step.index];
+            } else {
+                found.pos_ = std::string::npos;
+            }
+        }
+        return found;
+    }
+
+
+
+    // json pointer
+    json::pointer::pointer() : valid_(true) {}
+    json::pointer::pointer(const std::string& text) {
+        compile(text.data(), text.size());
+    }
+    json::pointer::pointer(const char* text) {
+        compile(text, strlen(text));
+    }
+    void json::pointer::compile(const char* text, size_t len) {
+        steps_.clear();
+        valid_ = len == 0 || text[0] == '/';
+        for (size_t pos = 1; valid_ && pos <= len; ++ pos) {
+            step token;
+            for (; pos < len && text[pos] != '/'; ++ pos) {
+                if (text[pos] != '~') {
+                    token.key += text[pos];
+                } else if (pos + 1 < len && (text[pos + 1] == '0' || text[pos + 1] == '1')) {
+                    token.key += text[++ pos] == '0' ? '~' : '/';
+                } else {
+                    valid_ = false;
+                }
+            }
+            // 0 or digits without a leading zero, and not past what size_t holds
+            token.index = std::string::npos;
+            const std::string& key = token.key;
+            if (!key.empty() && key.size() <= 18 && (key[0] != '0' || key.size() == 1)
+                && key.find_first_not_of("0123456789") == std::string::npos) {
+                token.index = (size_t)std::stoull(key);
+            }
+            steps_.push_back(std::move(token));
+        }
+        if (!valid_) {
+            steps_.clear();
+        }
+    }
+    bool json::pointer::valid() {
+        return valid_;
+    }
+    size_t json::pointer::size() {
+        return steps_.size();
+    }
+    json* json::find(const pointer& at) {
+        if (!at.valid_) {
+            return nullptr;
+        }
+        json* found = this;
+        for (const pointer::step& step : at.steps_) {
+            if (found->type_ == JSON_OBJECT) {
+                found = found->objectFind(step.key.data(), step.key.size());
+            } else if (found->type_ == JSON_ARRAY && step.index < found->array_->size()) {
+                found = &(*found->array_)[step.index];
+            } else {
+                found = nullptr;
+            }
+            if (found == nullptr) {
+                return nullptr;
+            }
+        }
+        return found;
+    }
+    // the containers on the path are followed, every other one is passed over without events;
+    // a false return ends the parse once the value is out or cannot come any more
+    struct json::pointerSink : json::handler {
+        const pointer& at;
+        handler& h;
+        size_t depth = 0;       // containers open
+        size_t level = 0;       // of them, the ones on the path
+        size_t next = 0;        // index of the next element when the innermost one is an array
+        bool array = false;     // the innermost container on the path
+        bool keyMatch = false;  // the last key in it was the token
+        size_t target = 0;      // depth + 1 the value was found at, 0 until then
+        bool done = false;      // stopped here, not by h
+        pointerSink(const pointer& p, handler& handler) : at(p), h(handler) {}
+        // at the start of a value; 1 to forward it, 0 to pass it over, -1 to stop
+        int begin() {
+            if (target != 0) { return 1; }
+            if (depth != level) { return 0; }
+            bool hit = level == 0 || (array ? next ++ == at.steps_[level - 1].index : keyMatch);
+            keyMatch = false;
+            if (!hit) { return 0; }
+            if (level == at.steps_.size()) {
+                target = depth + 1;
+                return 1;
+            }
+            return -1; // a container goes on in open()
+        }
+        bool stop() {
+            done = true;
+            return false;
+        }
+        bool scalar(bool forwarded) {
+            if (target == depth + 1 && forwarded) { return stop(); } // the value was a scalar
+            return forwarded;
+        }
+        bool open(bool isArray) {
+            int go = begin();
+            ++ depth;
+            if (go == 1) { return isArray ? h.startArray() : h.startObject(); }
+            if (go == -1) {
+                level = depth;
+                array = isArray;
+                next = 0;
+            }
+            return true;
+        }
+        bool close(bool isArray, size_t count) {
+            if (target != 0) {
+                bool ok = isArray ? h.endArray(count) : h.endObject(count);
+                -- depth;
+                if (ok && depth + 1 == target) { return stop(); }
+                return ok;
+            }
+            // the container on the path ends without the token
+            if (depth -- == level) { return stop(); }
+            return true;
+        }
+        bool leaf(int go, bool forwarded) {
+            if (go == -1) { return stop(); } // the path goes through a scalar
+            return go == 1 ? scalar(forwarded) : true;
+        }
+        bool null() { int go = begin(); return leaf(go, go != 1 || h.null()); }
+        bool boolean(bool b) { int go = begin(); return leaf(go, go != 1 || h.boolean(b)); }
+        bool number(double num) { int go = begin(); return leaf(go, go != 1 || h.number(num)); }
+        bool string(const stringView& str) { int go = begin(); return leaf(go, go != 1 || h.string(str)); }
+        bool startObject() { return open(false); }
+        bool startArray() { return open(true); }
+        bool endObject(size_t memberCount) { return close(false, memberCount); }
+        bool endArray(size_t elementCount) { return close(true, elementCount); }
+        bool key(const stringView& key) {
+            if (target != 0) { return h.key(key); }
+            if (depth == level && !array) {
+                const std::string& token = at.steps_[level - 1].key;
+                keyMatch = key == stringView(token.data(), token.size());
+            }
+            return true;
+        }
+    };
+    json::jsonError json::parse(const char* data, size_t len, const pointer& at, handler& h) {
+        if (!at.valid_) {
+            return JSON_PARSE_OK;
+        }
+        pointerSink sink(at, h);
+        jsonError ret = parse(data, len, sink);
+        return ret == JSON_PARSE_TERMINATED && sink.done ? JSON_PARSE_OK : ret;
+    }
+    json::jsonError json::parse(const stringView& jsonString, const pointer& at, handler& h) {
+        return parse(jsonString.data(), jsonString.size(), at, h);
+    }
+
+
+
+
+    // binary
+    void json::dumpCborHead(std::string& out, unsigned char major, uint64_t n) {
+        char head[9];
+        size_t size = n < 24 ? 0 : n <= 0xff ? 1 : n <= 0xffff ? 2 : n <= 0xffffffff ? 4 : 8;
+        head[0] = (char)((major << 5) | (size == 0 ? n : size == 1 ? 24 : size == 2 ? 25 : size == 4 ? 26 : 27));
+        for (size_t i = 0; i < size; ++ i) { // big endian
+            head[1 + i] = (char)(n >> (8 * (size - 1 - i)));
+        }
+        out.append(head, 1 + size);
+    }
+    void json::dumpCborNode(std::string& out) {
+        switch (type_) {
+            case JSON_NULL:     out += '\xf6';              break;
+            case JSON_FALSE:    out += '\xf4';              break;
+            case JSON_TRUE:     out += '\xf5';              break;
+            case JSON_NUMBER: {
+                // whole numbers read back exactly from an integer, but -0.0 stays a double
+                double num = number_;
+                if (num >= -9007199254740992.0 && num <= 9007199254740992.0 && num == (double)(int64_t)num
+                    && !(num == 0 && std::signbit(num))) {
+                    int64_t i = (int64_t)num;
+                    if (i >= 0) {
+                        dumpCborHead(out, 0, (uint64_t)i);
+                    } else {
+                        dumpCborHead(out, 1, (uint64_t)(-1 - i));
+                    }
+                    break;
+                }
+                uint64_t bits;
+                memcpy(&bits, &num, sizeof(bits));
+                out += '\xfb';
+                for (int i = 7; i >= 0; -- i) {
+                    out += (char)(bits >> (8 * i));
+                }
+                                                            break;
+            }
+            case JSON_STRING: {
+                stringView str = stringValue();
+                dumpCborHead(out, 3, str.size());
+                out.append(str.data(), str.size());
+                                                            break;
+            }
+            case JSON_ARRAY:    dumpCborHead(out, 4, array_->size());    break;
+            case JSON_OBJECT:   dumpCborHead(out, 5, object_->size());   break;
+            default:
+                                                            break;
+        }
+    }
+    void json::dumpCborValue(std::string& out) {
+        dumpCborNode(out);
+        if (!hasChildren()) {
+            return;
+        }
+        // open containers and the index of their next child, as in dumpValue()
+        std::vector<std::pair<json*, size_t>> stack;
+        stack.emplace_back(this, 0);
+        while (!stack.empty()) {
+            json* container = stack.back().first;
+            size_t i = stack.back().second;
+            json* child = nullptr;
+            if (container->type_ == JSON_ARRAY) {
+                arrayType& elements = *container->array_;
+                for (; i < elements.size() && child == nullptr; ++ i) {
+                    elements[i].dumpCborNode(out);
+                    if (elements[i].hasChildren()) { child = &elements[i]; }
+                }
+            } else {
+                objectType& members = *container->object_;
+                for (; i < members.size() && child == nullptr; ++ i) {
+                    dumpCborHead(out, 3, members[i].first.size());
+                    out.append(members[i].first.data(), members[i].first.size());
+                    members[i].second.dumpCborNode(out);
+                    if (members[i].second.hasChildren()) { child = &members[i].second; }
+                }
+            }
+            if (child == nullptr) {
+                stack.pop_back();
+            } else {
+                stack.back().second = i;
+                stack.emplace_back(child, 0);
+            }
+        }
+    }
+    std::string json::dumpCbor() {
+        std::string out;
+        dumpCborValue(out);
+        return out;
+    }
+    void json::dumpCbor(std::string& out) {
+        dumpCborValue(out);
+    }
+    // the initial byte and the argument after it: a length, a count, an integer or float bits
+    json::jsonError json::parseCborHead(parseContext& context, unsigned char& major, unsigned char& info, uint64_t& n) {
+        if (context.end()) {
+            return JSON_PARSE_BINARY_TRUNCATED;
+        }
+        unsigned char initial = (unsigned char)context.curPass();
+        major = initial >> 5;
+        info = initial & 31;
+        n = info;
+        if (info < 24) {
+            return JSON_PARSE_OK;
+        }
+        if (info > 27) { // reserved, or an indefinite length
+            return JSON_PARSE_INVALID_VALUE;
+        }
+        size_t size = size_t(1) << (info - 24);
+        if (context.left() < size) {
+            return JSON_PARSE_BINARY_TRUNCATED;
+        }
+        const unsigned char* p = (const unsigned char*)context.curPtr();
+        n = 0;
+        for (size_t i = 0; i < size; ++ i) {
+            n = (n << 8) | p[i];
+        }
+        context.pass(size);
+        return JSON_PARSE_OK;
+    }
+    // the containers open so far wait on a stack of their own, as in walkValue()
+    template<typename Sink>
+    json::jsonError json::parseCborValue(parseContext& context, Sink& sink) {
+        struct frame {
+            uint64_t left;  // values still to come
+            uint64_t count;
+            bool object;
+        };
+        std::vector<frame> stack;
+        size_t maxDepth = getMaxDepth();
+        unsigned char major, info;
+        uint64_t n;
+        jsonError ret;
+        for (;;) {
+            if (!stack.empty() && stack.back().object) {
+                if (!context.end() && ((unsigned char)context.cur() >> 5) != 3) {
+                    return JSON_PARSE_MISS_KEY;
+                }
+                ret = parseCborHead(context, major, info, n);
+                if (ret != JSON_PARSE_OK) { return ret; }
+                if (n > context.left()) { return JSON_PARSE_BINARY_TRUNCATED; }
+                if (!sink.key(stringView(context.curPtr(), (size_t)n))) { return JSON_PARSE_TERMINATED; }
+                context.pass((size_t)n);
+            }
+            ret = parseCborHead(context, major, info, n);
+            if (ret != JSON_PARSE_OK) {
+                return ret;
+            }
+            bool go;
+            switch (major) {
+                case 0: go = sink.number((double)n);         break;
+                case 1: go = sink.number(-1.0 - (double)n);  break;
+                case 3: {
+                    if (n > context.left()) { return JSON_PARSE_BINARY_TRUNCATED; }
+                    go = sink.string(stringView(context.curPtr(), (size_t)n));
+                    context.pass((size_t)n);
+                    break;
+                }
+                case 4:
+                case 5: {
+                    // every element takes a byte at least and every member two, a larger count is cut short
+                    if (n > context.left() / (major == 5 ? 2 : 1)) { return JSON_PARSE_BINARY_TRUNCATED; }
+                    if (stack.size() >= maxDepth) { return JSON_PARSE_DEPTH_EXCEEDED; }
+                    if (!(major == 5 ? sink.startObject() : sink.startArray())) { return JSON_PARSE_TERMINATED; }
+                    if (n > 0) {
+                        stack.push_back(frame{n, n, major == 5});
+                        continue;
+                    }
+                    go = major == 5 ? sink.endObject(0) : sink.endArray(0);
+                    break;
+                }
+                case 7: {
+                    if (info == 20 || info == 21) {
+                        go = sink.boolean(info == 21);
+                        break;
+                    }
+                    if (info == 22) {
+                        go = sink.null();
+                        break;
+                    }
+                    double num;
+                    switch (info) {
+                        case 25: { // half, RFC 8949 appendix D
+                            int exp = (int)(n >> 10) & 0x1f, mant = (int)n & 0x3ff;
+                            num = exp == 0 ? ldexp(mant, -24) : exp != 31 ? ldexp(mant + 1024, exp - 25)
+                                : mant == 0 ? HUGE_VAL : NAN;
+                            num = (n & 0x8000) ? -num : num;
+                            break;
+                        }
+                        case 26: {
+                            uint32_t bits = (uint32_t)n;
+                            float f;
+                            memcpy(&f, &bits, sizeof(f));
+                            num = f;
+                            break;
+                        }
+                        case 27:
+                            memcpy(&num, &n, sizeof(num));
+                            break;
+                        default: // undefined and other simple values
+                            return JSON_PARSE_INVALID_VALUE;
+                    }
+                    // as in parse(), only finite numbers
+                    if (std::isnan(num)) { return JSON_PARSE_INVALID_VALUE; }
+                    if (std::isinf(num)) { return JSON_PARSE_NUMBER_TOO_BIG; }
+                    go = sink.number(num);
+                    break;
+                }
+                default: // byte strings and tags
+                    return JSON_PARSE_INVALID_VALUE;
+            }
+            if (!go) {
+                return JSON_PARSE_TERMINATED;
+            }
+            // close the containers that are complete
+            for (;;) {
+                if (stack.empty()) {
+                    return JSON_PARSE_OK;
+                }
+                if (-- stack.back().left > 0) {
+                    break;
+                }
+                frame done = stack.back();
+                stack.pop_back();
+                if (!(done.object ? sink.endObject((size_t)done.count) : sink.endArray((size_t)done.count))) {
+                    return JSON_PARSE_TERMINATED;
+                }
+            }
+        }
+    }
+    json::jsonError json::parseCbor(const char* data, size_t len) {
+        setNull();
+        parseContext context(data, len);
+        treeSink sink(*this, context);
+        jsonError ret = context.end() ? JSON_PARSE_EXPECT_VALUE : parseCborValue(context, sink);
+        if (ret == JSON_PARSE_OK && !context.end()) {
+            ret = JSON_PARSE_ROOT_NOT_SINGULAR;
+        }
+        if (ret != JSON_PARSE_OK) {
+            setNull();
+        }
+        return ret;
+    }
+    json::jsonError json::parseCbor(const stringView& buffer) {
+        return parseCbor(buffer.data(), buffer.size());
+    }
+    json::jsonError json::parseCbor(const char* data, size_t len, handler& h) {
+        parseContext context(data, len);
+        eventSink sink{h};
+        jsonError ret = context.end() ? JSON_PARSE_EXPECT_VALUE : parseCborValue(context, sink);
+        if (ret == JSON_PARSE_OK && !context.end()) {
+            ret = JSON_PARSE_ROOT_NOT_SINGULAR;
+        }
+        return ret;
+    }
+
+
+
+
+    // double formatting, Grisu2 (Florian Loitsch) after Milo Yip's implementation:
+    // the shortest digits in almost all cases, always read back to the same double
+    struct diyFp {
+        uint64_t f;
+        int e;
+        diyFp() : f(0), e(0) {}
+        diyFp(uint64_t fp, int exp) : f(fp), e(exp) {}
+        explicit diyFp(double d) {
+            uint64_t u;
+            memcpy(&u, &d, sizeof(u));
+            int biasedE = (int)((u & 0x7ff0000000000000) >> 52);
+            uint64_t significand = u & 0x000fffffffffffff;
+            if (biasedE != 0) {
+                f = significand + 0x0010000000000000;
+                e = biasedE - 0x3ff - 52;
+            } else {
+                f = significand;
+                e = 1 - 0x3ff - 52;
+            }
+        }
+        diyFp operator-(const diyFp& rhs) const { return diyFp(f - rhs.f, e); }
+        diyFp operator*(const diyFp& rhs) const {
+            uint64_t high, low;
+            fullMultiply(f, rhs.f, high, low);
+            if (low & (uint64_t(1) << 63)) { ++ high; } // round
+            return diyFp(high, e + rhs.e + 64);
+        }
+        diyFp normalize() const {
+            int lz = leadingZeros64(f);
+            return diyFp(f << lz, e - lz);
+        }
+        // m- and m+, the halfway points to the neighbouring doubles
+        void normalizedBoundaries(diyFp& minus, diyFp& plus) const {
+            diyFp pl = diyFp((f << 1) + 1, e - 1).normalize();
+            diyFp mi = (f == 0x0010000000000000) ? diyFp((f << 2) - 1, e - 2) : diyFp((f << 1) - 1, e - 1);
+            mi.f <<= mi.e - pl.e;
+            mi.e = pl.e;
+            plus = pl;
+            minus = mi;
+        }
+    };
+    // 10^k for k = -348, -340, ..., 340
+    static diyFp cachedPower(int e, int& k) {
+        static const uint64_t cachedPowersF[] = {
+        0xfa8fd5a0081c0288, 0xbaaee17fa23ebf76, 0x8b16fb203055ac76, 0xcf42894a5dce35ea,
+        0x9a6bb0aa55653b2d, 0xe61acf033d1a45df, 0xab70fe17c79ac6ca, 0xff77b1fcbebcdc4f,
+        0xbe5691ef416bd60c, 0x8dd01fad907ffc3c, 0xd3515c2831559a83, 0x9d71ac8fada6c9b5,
+        0xea9c227723ee8bcb, 0xaecc49914078536d, 0x823c12795db6ce57, 0xc21094364dfb5637,
+        0x9096ea6f3848984f, 0xd77485cb25823ac7, 0xa086cfcd97bf97f4, 0xef340a98172aace5,
+        0xb23867fb2a35b28e, 0x84c8d4dfd2c63f3b, 0xc5dd44271ad3cdba, 0x936b9fcebb25c996,
+        0xdbac6c247d62a584, 0xa3ab66580d5fdaf6, 0xf3e2f893dec3f126, 0xb5b5ada8aaff80b8,
+        0x87625f056c7c4a8b, 0xc9bcff6034c13053, 0x964e858c91ba2655, 0xdff9772470297ebd,
+        0xa6dfbd9fb8e5b88f, 0xf8a95fcf88747d94, 0xb94470938fa89bcf, 0x8a08f0f8bf0f156b,
+        0xcdb02555653131b6, 0x993fe2c6d07b7fac, 0xe45c10c42a2b3b06, 0xaa242499697392d3,
+        0xfd87b5f28300ca0e, 0xbce5086492111aeb, 0x8cbccc096f5088cc, 0xd1b71758e219652c,
+        0x9c40000000000000, 0xe8d4a51000000000, 0xad78ebc5ac620000, 0x813f3978f8940984,
+        0xc097ce7bc90715b3, 0x8f7e32ce7bea5c70, 0xd5d238a4abe98068, 0x9f4f2726179a2245,
+        0xed63a231d4c4fb27, 0xb0de65388cc8ada8, 0x83c7088e1aab65db, 0xc45d1df942711d9a,
+        0x924d692ca61be758, 0xda01ee641a708dea, 0xa26da3999aef774a, 0xf209787bb47d6b85,
+        0xb454e4a179dd1877, 0x865b86925b9bc5c2, 0xc83553c5c8965d3d, 0x952ab45cfa97a0b3,
+        0xde469fbd99a05fe3, 0xa59bc234db398c25, 0xf6c69a72a3989f5c, 0xb7dcbf5354e9bece,
+        0x88fcf317f22241e2, 0xcc20ce9bd35c78a5, 0x98165af37b2153df, 0xe2a0b5dc971f303a,
+        0xa8d9d1535ce3b396, 0xfb9b7cd9a4a7443c, 0xbb764c4ca7a44410, 0x8bab8eefb6409c1a,
+        0xd01fef10a657842c, 0x9b10a4e5e9913129, 0xe7109bfba19c0c9d, 0xac2820d9623bf429,
+        0x80444b5e7aa7cf85, 0xbf21e44003acdd2d, 0x8e679c2f5e44ff8f, 0xd433179d9c8cb841,
+        0x9e19db92b4e31ba9, 0xeb96bf6ebadf77d9, 0xaf87023b9bf0ee6b,
+        };
+        static const int16_t cachedPowersE[] = {
+        -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980,
+        -954, -927, -901, -874, -847, -821, -794, -768, -741, -715,
+        -688, -661, -635, -608, -582, -555, -529, -502, -475, -449,
+        -422, -396, -369, -343, -316, -289, -263, -236, -210, -183,
+        -157, -130, -103, -77, -50, -24, 3, 30, 56, 83,
+        109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+        375, 402, 428, 455, 481, 508, 534, 561, 588, 614,
+        641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+        907, 933, 960, 986, 1013, 1039, 1066,
+        };
+        double dk = (-61 - e) * 0.30102999566398114 + 347; // dk must be positive, so can do ceiling in positive
+        int ik = (int)dk;
+        if (dk - ik > 0.0) { ++ ik; }
+        unsigned index = (unsigned)((ik >> 3) + 1);
+        k = -(-348 + (int)(index << 3)); // decimal exponent no need lookup table
+        return diyFp(cachedPowersF[index], cachedPowersE[index]);
+    }
+    static const uint64_t powerOfTen64[] = {
+        1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull,
+        1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull,
+        100000000000000ull, 1000000000000000ull, 10000000000000000ull, 100000000000000000ull,
+        1000000000000000000ull, 10000000000000000000ull
+    };
+    static void grisuRound(char* buffer, int len, uint64_t delta, uint64_t rest, uint64_t tenKappa, uint64_t wpW) {
+        while (rest < wpW && delta - rest >= tenKappa &&
+              (rest + tenKappa < wpW || wpW - rest > rest + tenKappa - wpW)) { // closer
+            buffer[len - 1] --;
+            rest += tenKappa;
+        }
+    }
+    static int countDecimalDigit32(uint32_t n) {
+        int d = 1;
+        while (n >= 10) { n /= 10; ++ d; }
+        return d;
+    }
+    static void digitGen(const diyFp& w, const diyFp& mp, uint64_t delta, char* buffer, int& len, int& k) {
+        const diyFp one(uint64_t(1) << -mp.e, mp.e);
+        const diyFp wpW = mp - w;
+        uint32_t p1 = (uint32_t)(mp.f >> -one.e);
+        uint64_t p2 = mp.f & (one.f - 1);
+        int kappa = countDecimalDigit32(p1);
+        len = 0;
+        while (kappa > 0) {
+            uint32_t pow10 = (uint32_t)powerOfTen64[kappa - 1];
+            uint32_t d = p1 / pow10;
+            p1 %= pow10;
+            if (d || len) { buffer[len ++] = (char)('0' + d); }
+            -- kappa;
+            uint64_t tmp = ((uint64_t)p1 << -one.e) + p2;
+            if (tmp <= delta) {
+                k += kappa;
+                grisuRound(buffer, len, delta, tmp, powerOfTen64[kappa] << -one.e, wpW.f);
+                return;
             }
-            insertObjectElement(key, elem);
-
-            parseWhitespace(context);
-            if (context.cur() == ',') {
-                context.curPass();
-                parseWhitespace(context);
-            } else if (context.cur() == '}') {
-                context.curPass();
-                // setObject();
-                return JSON_PARSE_OK;
-            } else {
-                ret = JSON_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
-                break;
+        }
+        for (;;) { // kappa = 0
+            p2 *= 10;
+            delta *= 10;
+            char d = (char)(p2 >> -one.e);
+            if (d || len) { buffer[len ++] = (char)('0' + d); }
+            p2 &= one.f - 1;
+            -- kappa;
+            if (p2 < delta) {
+                k += kappa;
+                int index = -kappa;
+                grisuRound(buffer, len, delta, p2, one.f, wpW.f * (index < 20 ? powerOfTen64[index] : 0));
+                return;
             }
         }
-        setNull();
-        return ret;
     }
-    json::jsonError json::parseValue(parseContext& context) {
-        switch (context.cur()) {
-            case 'n':  return parseLiteral(context, "null",  JSON_NULL);
-            case 't':  return parseLiteral(context, "true",  JSON_TRUE);
-            case 'f':  return parseLiteral(context, "false", JSON_FALSE);
-            case '\0': return JSON_PARSE_EXPECT_VALUE;
-            case '\"': return parseString(context);
-            case '[':  return parseArray(context);
-            case '{':  return parseObject(context);
-            default:   return parseNumber(context);
-        }
+    // digits of a finite positive double, value = buffer * 10^k
+    static void grisu2(double value, char* buffer, int& len, int& k) {
+        const diyFp v(value);
+        diyFp wm, wp;
+        v.normalizedBoundaries(wm, wp);
+        const diyFp cmk = cachedPower(wp.e, k);
+        const diyFp w = v.normalize() * cmk;
+        diyFp upper = wp * cmk;
+        diyFp lower = wm * cmk;
+        ++ lower.f;
+        -- upper.f;
+        digitGen(w, upper, upper.f - lower.f, buffer, len, k);
     }
-    json::jsonError json::parse(const std::string& jsonString) {
-        parseContext context(jsonString);
-        setNull();
-        parseWhitespace(context);
-        jsonError ret = parseValue(context);
-        if (ret == JSON_PARSE_OK) {
-            parseWhitespace(context);
-            if (context.idx() != jsonString.size()) {
-                setNull();
-                return JSON_PARSE_ROOT_NOT_SINGULAR;
+    static char* writeUnsigned(uint64_t u, char* buffer) {
+        char tmp[20];
+        int n = 0;
+        do { tmp[n ++] = (char)('0' + u % 10); u /= 10; } while (u);
+        while (n > 0) { *buffer ++ = tmp[-- n]; }
+        return buffer;
+    }
+    // writes at most 25 chars, same layout as "%.17g" but with the shortest digits
+    static int formatDouble(double value, char* buffer) {
+        char* p = buffer;
+        if (std::isnan(value) || std::isinf(value)) {
+            return sprintf(buffer, "%.17g", value);
+        }
+        if (std::signbit(value)) {
+            *p ++ = '-';
+            value = -value;
+        }
+        // integers below 2^53 are exact, print them without grisu
+        if (value < 9007199254740992.0 && value == (double)(uint64_t)value) {
+            return (int)(writeUnsigned((uint64_t)value, p) - buffer);
+        }
+        char digits[20];
+        int len, k;
+        grisu2(value, digits, len, k);
+        int exp10 = len + k - 1; // exponent of the first digit
+        if (exp10 >= -4 && exp10 < 17) {
+            if (exp10 < 0) { // 0.000ddd
+                *p ++ = '0';
+                *p ++ = '.';
+                for (int i = exp10 + 1; i < 0; ++ i) { *p ++ = '0'; }
+                memcpy(p, digits, len);
+                p += len;
+            } else if (k >= 0) { // ddd000
+                memcpy(p, digits, len);
+                p += len;
+                for (int i = 0; i < k; ++ i) { *p ++ = '0'; }
+            } else { // dd.ddd
+                memcpy(p, digits, exp10 + 1);
+                p += exp10 + 1;
+                *p ++ = '.';
+                memcpy(p, digits + exp10 + 1, len - exp10 - 1);
+                p += len - exp10 - 1;
             }
+        } else { // d.ddde+XX
+            *p ++ = digits[0];
+            if (len > 1) {
+                *p ++ = '.';
+                memcpy(p, digits + 1, len - 1);
+                p += len - 1;
+            }
+            *p ++ = 'e';
+            *p ++ = exp10 < 0 ? '-' : '+';
+            unsigned e = exp10 < 0 ? -exp10 : exp10;
+            if (e < 10) { *p ++ = '0'; }
+            p = writeUnsigned(e, p);
         }
-        return ret;
+        return (int)(p - buffer);
     }
-
-
-
-
-
-
-
-
-
-
-    void json::dumpString(std::string& dumpedString, const std::string& s) {
+    void json::dumpString(std::string& dumpedString, const char* s, size_t len, writer* w) {
         const char hexDigits[] = { '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'};
         dumpedString += '\"';
-        for (unsigned char ch : s) {
+        const char* p = s;
+        const char* end = p + len;
+        while (p < end) {
+            // append the clean span up to the next char that needs escaping
+            size_t run = findSpecialChar(p, end - p);
+            while (w != nullptr && dumpedString.size() + run >= writer::BLOCK) {
+                // a long run goes out a block at a time
+                size_t part = writer::BLOCK - std::min(dumpedString.size(), (size_t)writer::BLOCK);
+                dumpedString.append(p, part);
+                p += part;
+                run -= part;
+                w->drain();
+            }
+            dumpedString.append(p, run);
+            p += run;
+            if (p == end) { break; }
+            unsigned char ch = *p ++;
             switch (ch) {
                 case '\"': dumpedString += "\\\"";   break;
                 case '\\': dumpedString += "\\\\";   break;
@@ -620,86 +4076,359 @@ namespace xushun {
                 case '\r': dumpedString += "\\r";    break;
                 case '\t': dumpedString += "\\t";    break;
                 default:
-                    if (ch < 0x20) {
-                        dumpedString += "\\u00";
-                        dumpedString += hexDigits[ch >> 4];
-                        dumpedString += hexDigits[ch & 15];
-                    } else {
-                        dumpedString += ch;
-                    }
+                    dumpedString += "\\u00";
+                    dumpedString += hexDigits[ch >> 4];
+                    dumpedString += hexDigits[ch & 15];
+            }
+            if (w != nullptr && dumpedString.size() >= writer::BLOCK) {
+                w->drain();
             }
         }
         dumpedString += '\"';
     }
-    void json::dumpValue(std::string& dumpedString) {
+    void json::dumpLeaf(std::string& dumpedString, writer* w) {
         switch (type_) {
             case JSON_NULL:     dumpedString += "null";      break;
             case JSON_TRUE:     dumpedString += "true";      break;
             case JSON_FALSE:    dumpedString += "false";     break;
-            case JSON_NUMBER:
-                char num[32];
-                sprintf(num, "%.17g", number_);
-                dumpedString += std::string(num);            break;
-            case JSON_STRING: dumpString(dumpedString, string_);           
+            case JSON_NUMBER: {
+                // format straight into the output
+                size_t size = dumpedString.size();
+                dumpedString.resize(size + 32);
+                dumpedString.resize(size + formatDouble(number_, &dumpedString[size]));
                                                             break;
-            case JSON_ARRAY:
-                dumpedString += "[";
-                for (int i = 0; i < array_.size(); ++ i) {
-                    if (i > 0) { dumpedString += ","; }
-                    array_[i].dumpValue(dumpedString);
-                }
-                dumpedString += "]";                         break;
-            case JSON_OBJECT:
-                dumpedString += "{";
-                for (auto itr = object_.begin(); itr != object_.end(); ++ itr) {
-                    if (itr != object_.begin()) { dumpedString += ","; }
-                    dumpString(dumpedString, itr->first);
-                    dumpedString += ":";
-                    itr->second.dumpValue(dumpedString);
-                }
-                dumpedString += "}";                         break;
-            default: 
+            }
+            case JSON_STRING: {
+                stringView str = stringValue();
+                dumpString(dumpedString, str.data(), str.size(), w);
                                                             break;
+            }
+            case JSON_ARRAY:    dumpedString += "[]";        break;
+            case JSON_OBJECT:   dumpedString += "{}";        break;
+            default:                                        break;
+        }
+    }
+    void json::dumpValue(std::string& dumpedString, writer* w, dumpStack* reuse) {
+        if (!hasChildren()) {
+            dumpLeaf(dumpedString, w);
+            return;
+        }
+        // a loop per level
+        dumpStack local;
+        dumpStack& stack = reuse != nullptr ? *reuse : local;
+        stack.clear();
+        stack.emplace_back(this, 0);
+        dumpedString += type_ == JSON_ARRAY ? '[' : '{';
+        while (!stack.empty()) {
+            if (w != nullptr && dumpedString.size() >= writer::BLOCK) { w->drain(); }
+            json* container = stack.back().first;
+            size_t i = stack.back().second;
+            json* child = nullptr;
+            if (container->type_ == JSON_ARRAY) {
+                arrayType& elements = *container->array_;
+                for (; i < elements.size(); ++ i) {
+                    if (w != nullptr && dumpedString.size() >= writer::BLOCK) { w->drain(); }
+                    if (i > 0) { dumpedString += ','; }
+                    if (elements[i].hasChildren()) {
+                        child = &elements[i];
+                        break;
+                    }
+                    elements[i].dumpLeaf(dumpedString, w);
+                }
+            } else {
+                objectType& members = *container->object_;
+                for (; i < members.size(); ++ i) {
+                    if (w != nullptr && dumpedString.size() >= writer::BLOCK) { w->drain(); }
+                    if (i > 0) { dumpedString += ','; }
+                    dumpString(dumpedString, members[i].first.data(), members[i].first.size(), w);
+                    dumpedString += ':';
+                    if (members[i].second.hasChildren()) {
+                        child = &members[i].second;
+                        break;
+                    }
+                    members[i].second.dumpLeaf(dumpedString, w);
+                }
+            }
+            if (child == nullptr) {
+                dumpedString += container->type_ == JSON_ARRAY ? ']' : '}';
+                stack.pop_back();
+            } else {
+                stack.back().second = i + 1;
+                stack.emplace_back(child, 0);
+                dumpedString += child->type_ == JSON_ARRAY ? '[' : '{';
+            }
         }
     }
     std::string json::dump() {
-        dumpValue(dumpedString_);
-        return dumpedString_;
+        std::string dumpedString;
+        dumpValue(dumpedString);
+        return dumpedString;
+    }
+    void json::dumpChildren(std::string& dumpedString, size_t begin, size_t end, writer* w, dumpStack* reuse) {
+        for (size_t i = begin; i < end; ++ i) {
+            if (i > 0) { dumpedString += ','; }
+            if (type_ == JSON_ARRAY) {
+                (*array_)[i].dumpValue(dumpedString, w, reuse);
+            } else {
+                memberType& member = (*object_)[i];
+                dumpString(dumpedString, member.first.data(), member.first.size(), w);
+                dumpedString += ':';
+                member.second.dumpValue(dumpedString, w, reuse);
+            }
+            if (w != nullptr && dumpedString.size() >= writer::BLOCK) { w->drain(); }
+        }
+    }
+    void json::dumpParallel(std::string& dumpedString, writer* w, unsigned threads) {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        auto children = [](json* value) -> size_t {
+            if (!value->hasChildren()) { return 0; }
+            return value->type_ == JSON_ARRAY ? value->array_->size() : value->object_->size();
+        };
+        // the containers above the one that is cut, with the child followed in each
+        dumpStack path;
+        json* cut = this;
+        while (children(cut) < threads) {
+            size_t most = 0, index = 0;
+            for (size_t i = 0; i < children(cut); ++ i) {
+                json* child = cut->type_ == JSON_ARRAY ? &(*cut->array_)[i] : &(*cut->object_)[i].second;
+                if (children(child) > most) {
+                    most = children(child);
+                    index = i;
+                }
+            }
+            if (most == 0) { break; }
+            path.emplace_back(cut, index);
+            cut = cut->type_ == JSON_ARRAY ? &(*cut->array_)[index] : &(*cut->object_)[index].second;
+        }
+        size_t n = children(cut);
+        if (threads < 2 || n < 2) {
+            dumpValue(dumpedString, w);
+            return;
+        }
+        std::vector<dumpStack> stacks(threads);
+        for (std::pair<json*, size_t>& level : path) {
+            json* container = level.first;
+            dumpedString += container->type_ == JSON_ARRAY ? '[' : '{';
+            container->dumpChildren(dumpedString, 0, level.second, w, &stacks[0]);
+            if (level.second > 0) { dumpedString += ','; }
+            if (container->type_ == JSON_OBJECT) {
+                memberType& member = (*container->object_)[level.second];
+                dumpString(dumpedString, member.first.data(), member.first.size(), w);
+                dumpedString += ':';
+            }
+        }
+        dumpedString += cut->type_ == JSON_ARRAY ? '[' : '{';
+        // into a string all slices at once; to a writer in rounds, sized from the rounds before
+        std::vector<std::string> buffers(threads);
+        size_t step = w == nullptr ? (n + threads - 1) / threads : 64;
+        for (size_t done = 0; done < n && (w == nullptr || w->good_); ) {
+            std::vector<size_t> bounds(1, done);
+            while (bounds.size() <= threads && bounds.back() < n) {
+                bounds.push_back(std::min(n, bounds.back() + step));
+            }
+            size_t parts = bounds.size() - 1;
+            std::vector<std::thread> workers;
+            for (size_t k = 1; k < parts; ++ k) {
+                workers.emplace_back([&, k]() {
+                    buffers[k].clear();
+                    cut->dumpChildren(buffers[k], bounds[k], bounds[k + 1], nullptr, &stacks[k]);
+                });
+            }
+            // the first slice goes straight to the output
+            cut->dumpChildren(dumpedString, bounds[0], bounds[1], w, &stacks[0]);
+            for (std::thread& worker : workers) {
+                worker.join();
+            }
+            size_t bytes = 0;
+            for (size_t k = 1; k < parts; ++ k) {
+                bytes += buffers[k].size();
+            }
+            if (w != nullptr) {
+                w->drain();
+                for (size_t k = 1; k < parts; ++ k) {
+                    w->put(buffers[k].data(), buffers[k].size());
+                }
+                if (bytes > 0) {
+                    step = std::max((size_t)1, (size_t)(PARALLEL_SLICE * (double)(bounds[parts] - bounds[1]) / bytes));
+                }
+            } else {
+                dumpedString.reserve(dumpedString.size() + bytes);
+                for (size_t k = 1; k < parts; ++ k) {
+                    dumpedString += buffers[k];
+                }
+            }
+            done = bounds[parts];
+        }
+        dumpedString += cut->type_ == JSON_ARRAY ? ']' : '}';
+        for (size_t level = path.size(); level-- > 0; ) {
+            json* container = path[level].first;
+            container->dumpChildren(dumpedString, path[level].second + 1, children(container), w, &stacks[0]);
+            dumpedString += container->type_ == JSON_ARRAY ? ']' : '}';
+        }
+    }
+    std::string json::dumpParallel(unsigned threads) {
+        std::string dumpedString;
+        dumpParallel(dumpedString, nullptr, threads);
+        return dumpedString;
+    }
+    const std::string& json::serializer::dump(json& value) {
+        out_.clear();
+        value.dumpValue(out_, nullptr, &stack_);
+        return out_;
+    }
+    json::writer::writer(std::ostream& out) : sink_([&out](const char* data, size_t len) {
+        return (bool)out.write(data, len);
+    }) {
+        init();
+    }
+    json::writer::writer(FILE* file) : sink_([file](const char* data, size_t len) {
+        return fwrite(data, 1, len, file) == len;
+    }) {
+        init();
+    }
+    json::writer::writer(int fd) : sink_([fd](const char* data, size_t len) {
+#if defined(__unix__) || defined(__APPLE__)
+        while (len > 0) {
+            ssize_t n = ::write(fd, data, len);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return false;
+            }
+            data += n;
+            len -= n;
+        }
+        return true;
+#else
+        return false;
+#endif
+    }) {
+        init();
+    }
+    json::writer::writer(char* buffer, size_t size) : sink_([buffer, size, this](const char* data, size_t len) {
+        if (len > size - size_) {
+            return false;
+        }
+        memcpy(buffer + size_, data, len);
+        return true;
+    }) {
+        init();
+    }
+    json::writer::writer(const callback& sink) : sink_(sink) {
+        init();
+    }
+    json::writer::~writer() {
+        flush();
+    }
+    void json::writer::init() {
+        // the block is drained before it passes BLOCK by more than a few bytes, it never moves
+        block_.reserve(2 * BLOCK);
+        size_ = 0;
+        good_ = true;
+    }
+    void json::writer::drain() {
+        put(block_.data(), block_.size());
+        block_.clear();
+    }
+    void json::writer::put(const char* data, size_t len) {
+        if (good_ && len > 0) {
+            good_ = sink_(data, len);
+            size_ += good_ ? len : 0;
+        }
+    }
+    bool json::writer::write(json& value) {
+        value.dumpValue(block_, this, &stack_);
+        if (block_.size() >= BLOCK) {
+            drain();
+        }
+        return good_;
+    }
+    bool json::writer::write(json& value, unsigned threads) {
+        value.dumpParallel(block_, this, threads);
+        if (block_.size() >= BLOCK) {
+            drain();
+        }
+        return good_;
+    }
+    bool json::writer::write(const char* data, size_t len) {
+        if (block_.size() + len > BLOCK) {
+            drain();
+        }
+        if (len >= BLOCK) {
+            put(data, len);
+        } else {
+            block_.append(data, len);
+        }
+        return good_;
+    }
+    bool json::writer::flush() {
+        drain();
+        return good_;
+    }
+    bool json::writer::good() {
+        return good_;
+    }
+    size_t json::writer::size() {
+        return size_;
     }
 
 
     // equal and operator==
     bool json::isEqual(const json& rhs) {
-        if (type_ != rhs.type_) { return false; }
-        switch (type_) {
+        pairList deeper;
+        if (!isEqualBelow(*this, rhs, 0, deeper)) { return false; }
+        while (!deeper.empty()) {
+            std::pair<const json*, const json*> top = deeper.back();
+            deeper.pop_back();
+            if (!isEqualBelow(*top.first, *top.second, 0, deeper)) { return false; }
+        }
+        return true;
+    }
+    bool json::isEqualBelow(const json& lhs, const json& rhs, size_t depth, pairList& deeper) {
+        const size_t EQUAL_DEPTH = 64;
+        if (lhs.type_ != rhs.type_) { return false; }
+        switch (lhs.type_) {
             case JSON_OBJECT:
-                if (object_.size() != rhs.object_.size()) { return false; }
-                for (std::pair<std::string, json> pr : object_) {
-                    if (rhs.object_.find(pr.first) == rhs.object_.end()) { return false; }
-                    if (!pr.second.isEqual(rhs.object_.at(pr.first))) { return false; }
+                if (lhs.object_->size() != rhs.object_->size()) { return false; }
+                for (auto& pr : *lhs.object_) {
+                    json* found = const_cast<json&>(rhs).objectFind(pr.first.data(), pr.first.size());
+                    if (found == nullptr) { return false; }
+                    if (depth == EQUAL_DEPTH && pr.second.hasChildren()) {
+                        deeper.emplace_back(&pr.second, found);
+                    } else if (!isEqualBelow(pr.second, *found, depth + 1, deeper)) {
+                        return false;
+                    }
                 }
                 return true;
             case JSON_ARRAY:
-                if (array_.size() != rhs.array_.size()) { return false; }
-                for (int i = 0; i < array_.size(); ++ i) {
-                    if (!array_[i].isEqual(rhs.array_[i])) { return false; }
+                if (lhs.array_->size() != rhs.array_->size()) { return false; }
+                for (size_t i = 0; i < lhs.array_->size(); ++ i) {
+                    const json& elem = (*lhs.array_)[i];
+                    if (depth == EQUAL_DEPTH && elem.hasChildren()) {
+                        deeper.emplace_back(&elem, &(*rhs.array_)[i]);
+                    } else if (!isEqualBelow(elem, (*rhs.array_)[i], depth + 1, deeper)) {
+                        return false;
+                    }
                 }
                 return true;
             case JSON_STRING:
-                return string_ == rhs.string_;
+                return lhs.stringValue() == rhs.stringValue();
             case JSON_NUMBER:
-                return number_ == rhs.number_;
+                return lhs.number_ == rhs.number_;
             default:
                 return true;
         }
     }
     bool json::isEqual(const std::string& str) {
         if (getType() != json::JSON_STRING) { return false; }
-        return string_ == str;
+        return stringValue() == stringView(str.data(), str.size());
     }
     bool json::isEqual(const char* str) {
         if (getType() != json::JSON_STRING) { return false; }
-        return string_ == std::string(str);
+        return stringValue() == stringView(str, strlen(str));
     }
     bool json::isEqual(double num) {
         if (getType() != json::JSON_NUMBER) { return false;}
@@ -713,7 +4442,7 @@ namespace xushun {
     bool json::isEqual(const std::vector<T>& vec) {
         if (getType() != json::JSON_ARRAY) { return false; }
         if (vec.size() != getArraySize()) { return false; }
-        for (int i = 0; i < vec.size(); ++ i) {
+        for (size_t i = 0; i < vec.size(); ++ i) {
             if (!getArrayElement(i).isEqual(vec[i])) {
                 return false;
             }
@@ -776,15 +4505,225 @@ namespace xushun {
 
 
 
+    // value storage
+    void json::copyValue(const json& src) { // this must be null, the copy uses the storage of this
+        copyList deeper;
+        copyBelow(src, 0, deeper);
+        while (!deeper.empty()) {
+            std::pair<json*, const json*> top = deeper.back();
+            deeper.pop_back();
+            top.first->copyBelow(*top.second, 0, deeper);
+        }
+    }
+    // recursion up to a fixed depth, the containers below wait on a list still null
+    void json::copyBelow(const json& src, size_t depth, copyList& deeper) {
+        const size_t COPY_DEPTH = 64;
+        keepOrder_ = src.keepOrder_;
+        switch (src.type_) {
+            case JSON_OBJECT:
+                object_ = create<objectType>(allocator());
+                object_->reserve(src.object_->size());
+                for (auto& pr : *src.object_) {
+                    object_->emplace_back(keyType(pr.first.data(), pr.first.size(), allocator().arena_), json());
+                    json& member = inherit(object_->back().second);
+                    if (depth == COPY_DEPTH && pr.second.hasChildren()) {
+                        deeper.emplace_back(&member, &pr.second);
+                    } else {
+                        member.copyBelow(pr.second, depth + 1, deeper);
+                    }
+                }
+                break;
+            case JSON_ARRAY:
+                array_ = create<arrayType>(allocator());
+                array_->reserve(src.array_->size());
+                for (const json& elem : *src.array_) {
+                    array_->emplace_back();
+                    json& element = inherit(array_->back());
+                    if (depth == COPY_DEPTH && elem.hasChildren()) {
+                        deeper.emplace_back(&element, &elem);
+                    } else {
+                        element.copyBelow(elem, depth + 1, deeper);
+                    }
+                }
+                break;
+            case JSON_STRING: {
+                stringView str = src.stringValue();
+                initString(str.data(), str.size());
+                break;
+            }
+            case JSON_NUMBER:
+                number_ = src.number_;
+                break;
+            default:
+                break;
+        }
+        type_ = src.type_;
+    }
+    void json::takeValue(json& src) { // this must be null
+        if (src.ownsArena_ && arena_ == 0) {
+            // the document changes hands
+            arena_ = src.arena_;
+            ownsArena_ = true;
+            src.arena_ = 0;
+            src.ownsArena_ = false;
+        } else if (src.arena_ != arena_ || src.ownsArena_) {
+            // the storage lives elsewhere, src keeps it
+            copyValue(src);
+            return;
+        }
+        type_ = src.type_;
+        number_ = src.number_;
+        keepOrder_ = src.keepOrder_;
+        shortSize_ = src.shortSize_;
+        src.type_ = JSON_NULL;
+    }
+    // destructors free the levels below a container up to a fixed depth, containers deeper
+    // than that are moved out to a list and freed from there, a subtree at a time
+    static thread_local size_t freeDepth = 0;
+    static thread_local std::vector<json>* freeDeeper = nullptr;
+    void json::freeValue() {
+        if (arena_ == 0) {
+            switch (type_) {
+                case JSON_OBJECT:
+                case JSON_ARRAY:
+                    if (freeDepth - 1 < FREE_DEPTH - 1) { // inside a container being freed
+                        ++ freeDepth;
+                        deleteContainer();
+                        -- freeDepth;
+                    } else {
+                        freeContainer();
+                    }
+                    break;
+                case JSON_STRING:
+                    if (shortSize_ == LONG_STRING) {
+                        delete string_;
+                    }
+                    break;
+                default:                          break;
+            }
+        } else if (ownsArena_) {
+            arenaOf(arena_)->reset();
+        }
+        // an arena node leaves its storage to the arena
+        type_ = JSON_NULL;
+    }
+    void json::freeContainer() {
+        if (freeDepth == FREE_DEPTH) {
+            freeDeeper->push_back(std::move(*this));
+            return;
+        }
+        std::vector<json> list;
+        freeDeeper = &list;
+        json node;
+        node.takeValue(*this);
+        for (;;) {
+            ++ freeDepth;
+            node.deleteContainer();
+            -- freeDepth;
+            if (list.empty()) {
+                break;
+            }
+            node.takeValue(list.back());
+            list.pop_back();
+        }
+        freeDeeper = nullptr;
+    }
+    void json::deleteContainer() {
+        if (type_ == JSON_ARRAY) {
+            delete array_;
+        } else {
+            delete object_;
+        }
+        type_ = JSON_NULL;
+    }
+
+
+
+    // arena documents
+    // ids index a table of 1024 blocks of 1024 arenas, blocks never move
+    struct json::arenaTable {
+        std::mutex mutex;
+        std::atomic<arena**> blocks[1024];
+        std::vector<uint32_t> freeIds;
+        uint32_t nextId = 1;
+    };
+    json::arenaTable& json::arenas() {
+        static arenaTable table;
+        return table;
+    }
+    uint32_t json::arenaAttach(arena* a) {
+        arenaTable& table = arenas();
+        std::lock_guard<std::mutex> lock(table.mutex);
+        uint32_t id;
+        if (!table.freeIds.empty()) {
+            id = table.freeIds.back();
+            table.freeIds.pop_back();
+        } else if (table.nextId < (1u << 20)) {
+            id = table.nextId ++;
+        } else {
+            return 0;
+        }
+        arena** block = table.blocks[id >> 10].load(std::memory_order_acquire);
+        if (block == nullptr) {
+            block = new arena*[1024]();
+            table.blocks[id >> 10].store(block, std::memory_order_release);
+        }
+        block[id & 1023] = a;
+        return id;
+    }
+    void json::arenaDetach(uint32_t id) {
+        arenaTable& table = arenas();
+        std::lock_guard<std::mutex> lock(table.mutex);
+        table.blocks[id >> 10].load(std::memory_order_acquire)[id & 1023] = nullptr;
+        table.freeIds.push_back(id);
+    }
+    arena* json::arenaOf(uint32_t id) {
+        return arenas().blocks[id >> 10].load(std::memory_order_acquire)[id & 1023];
+    }
+    arenaAllocator<char> json::allocator() {
+        return arenaAllocator<char>(arena_ == 0 ? nullptr : arenaOf(arena_));
+    }
+    template<typename T, typename... Args>
+    T* json::create(Args&&... args) {
+        if (arena_ == 0) {
+            return new T(std::forward<Args>(args)...);
+        }
+        return new (arenaOf(arena_)->allocate(sizeof(T))) T(std::forward<Args>(args)...);
+    }
+    json& json::inherit(json& child) {
+        child.arena_ = arena_;
+        child.keepOrder_ = keepOrder_;
+        return child;
+    }
+    bool json::setArena() {
+        if (arena_ != 0) {
+            return ownsArena_;
+        }
+        arena* a = new arena();
+        uint32_t id = arenaAttach(a);
+        if (id == 0) {
+            delete a; // out of ids, stays on the heap
+            return false;
+        }
+        json tmp;
+        tmp.takeValue(*this);
+        arena_ = id;
+        ownsArena_ = true;
+        copyValue(tmp);
+        return true;
+    }
+    bool json::isArena() {
+        return arena_ != 0;
+    }
+
+
+
     // value access
     json::jsonType json::getType() {
         return type_;
     }
     void json::setNull() {
-        type_ = JSON_NULL;
-        object_.clear();
-        array_.clear();
-        string_.clear();
+        freeValue();
     }
 
     // boolean
@@ -799,7 +4738,7 @@ namespace xushun {
 
     // number
     double json::getNumber() {
-        return number_;
+        return type_ == JSON_NUMBER ? number_ : 0.0;
     }
     void json::setNumber(double n) {
         setNull();
@@ -808,47 +4747,123 @@ namespace xushun {
     }
 
     // string
+    stringView json::stringValue() const {
+        if (shortSize_ == LONG_STRING) {
+            return stringView(string_->data(), string_->size());
+        }
+        return stringView(short_, shortSize_);
+    }
     std::string json::getString() {
-        int idx = string_.find('\0');
-        if (idx < string_.size()) {
-            return string_.substr(0, idx);
+        if (type_ != JSON_STRING) {
+            return std::string();
         }
-        return string_;
+        stringView str = stringValue();
+        const char* nul = (const char*)memchr(str.data(), '\0', str.size());
+        return std::string(str.data(), nul == nullptr ? str.size() : nul - str.data());
     }
-    void json::setString(const std::string& s) {
-        setNull();
+    stringView json::getStringView() {
+        return type_ == JSON_STRING ? stringValue() : stringView();
+    }
+    size_t json::getStringLength() {
+        return type_ == JSON_STRING ? stringValue().size() : 0;
+    }
+    void json::initString(const char* s, size_t len) {
+        if (len <= SHORT_STRING_MAX) {
+            memcpy(short_, s, len);
+            shortSize_ = (unsigned char)len;
+        } else {
+            string_ = create<stringType>(s, len, allocator());
+            shortSize_ = LONG_STRING;
+        }
         type_ = JSON_STRING;
-        string_ = s;
+    }
+    void json::setStringRaw(const char* s, size_t len) {
+        if (type_ == JSON_STRING && shortSize_ == LONG_STRING && len > SHORT_STRING_MAX) {
+            string_->assign(s, len); // the buffer is reused
+            return;
+        }
+        char buf[SHORT_STRING_MAX];
+        if (len <= SHORT_STRING_MAX) {
+            // s may point into this value
+            memcpy(buf, s, len);
+            s = buf;
+        }
+        setNull();
+        initString(s, len);
+    }
+    void json::setString(const std::string& s) {
+        setStringRaw(s.data(), s.size());
+    }
+    void json::setString(std::string&& s) {
+        setStringRaw(s.data(), s.size());
     }
 
 
     // array
     void json::setArray() {
         setNull();
+        array_ = create<arrayType>(allocator());
         type_ = JSON_ARRAY;
     }
-    int json::getArraySize() {
-        return array_.size();
+    size_t json::getArraySize() {
+        return type_ == JSON_ARRAY ? array_->size() : 0;
     }
     void json::clearArray() {
-        array_.clear();
+        if (type_ == JSON_ARRAY) {
+            array_->clear();
+        }
+    }
+    json& json::getArrayElement(size_t index) {
+        return (*array_)[index];
+    }
+    // an element is first brought into the storage of this value,
+    // then moved in, j may live inside this array
+    void json::pushbackArray(const json& j) {
+        json tmp;
+        inherit(tmp).copyValue(j);
+        if (type_ != JSON_ARRAY) {
+            setArray();
+        }
+        array_->push_back(std::move(tmp));
     }
-    json& json::getArrayElement(int index) {
-        return array_[index];
+    void json::pushbackArray(json&& j) {
+        json tmp;
+        inherit(tmp) = std::move(j);
+        if (type_ != JSON_ARRAY) {
+            setArray();
+        }
+        array_->push_back(std::move(tmp));
     }
-    void json::pushbackArray(const json j) {
-        array_.push_back(j);
+    json& json::emplacebackArray() {
+        if (type_ != JSON_ARRAY) {
+            setArray();
+        }
+        array_->emplace_back();
+        return inherit(array_->back());
     }
     void json::popbackArray() {
-        array_.pop_back();
+        array_->pop_back();
+    }
+    void json::insertArrayElement(size_t index, const json& j) {
+        json tmp;
+        inherit(tmp).copyValue(j);
+        if (type_ != JSON_ARRAY) {
+            setArray();
+        }
+        array_->insert(array_->begin() + index, std::move(tmp));
     }
-    void json::insertArrayElement(int index, json j) {
-        array_.insert(array_.begin() + index, j);
+    void json::insertArrayElement(size_t index, json&& j) {
+        json tmp;
+        inherit(tmp) = std::move(j);
+        if (type_ != JSON_ARRAY) {
+            setArray();
+        }
+        array_->insert(array_->begin() + index, std::move(tmp));
     }
-    void json::eraseArrayElement(int index, int count) {
-        array_.erase(array_.begin() + index, array_.begin() + index + count);
+    void json::eraseArrayElement(size_t index, size_t count) {
+        array_->erase(array_->begin() + index, array_->begin() + index + count);
     }
-    json& json::operator[](int index) {
+    json& json::operator[](size_t index) {
         return getArrayElement(index);
     }
 
@@ -856,44 +4871,221 @@ namespace xushun {
     // object
     void json::setObject() {
         setNull();
+        object_ = create<objectType>(allocator());
         type_ = JSON_OBJECT;
     }
-    int json::getObjectSize() {
-        return object_.size();
+    size_t json::getObjectSize() {
+        return type_ == JSON_OBJECT ? object_->size() : 0;
     }
     void json::clearObject() {
-        object_.clear();
+        if (type_ == JSON_OBJECT) {
+            object_->clear();
+        }
+    }
+    // byte order, the order std::string compares in
+    static bool keyLess(const char* a, size_t lenA, const char* b, size_t lenB) {
+        int cmp = memcmp(a, b, std::min(lenA, lenB));
+        return cmp < 0 || (cmp == 0 && lenA < lenB);
+    }
+    size_t json::objectIndex(const char* key, size_t len) {
+        objectType& members = *object_;
+        if (keepOrder_ || members.size() <= 8) {
+            // small or unsorted, a linear scan
+            if (len <= 15) {
+                keyType probe(key, len, nullptr); // inline, compared as 16 bytes
+                for (size_t i = 0; i < members.size(); ++ i) {
+                    if (members[i].first == probe) {
+                        return i;
+                    }
+                }
+                return std::string::npos;
+            }
+            for (size_t i = 0; i < members.size(); ++ i) {
+                if (members[i].first.size() == len && memcmp(members[i].first.data(), key, len) == 0) {
+                    return i;
+                }
+            }
+            return std::string::npos;
+        }
+        size_t lo = 0, hi = members.size();
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            if (keyLess(members[mid].first.data(), members[mid].first.size(), key, len)) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        if (lo < members.size() && members[lo].first.size() == len && memcmp(members[lo].first.data(), key, len) == 0) {
+            return lo;
+        }
+        return std::string::npos;
+    }
+    json* json::objectFind(const char* key, size_t len) {
+        size_t index = objectIndex(key, len);
+        return index == std::string::npos ? nullptr : &(*object_)[index].second;
+    }
+    json& json::objectSlot(const char* key, size_t len) { // find or insert a null member
+        if (type_ != JSON_OBJECT) {
+            setObject();
+        }
+        json* found = objectFind(key, len);
+        if (found != nullptr) {
+            return *found;
+        }
+        objectType& members = *object_;
+        auto pos = members.end();
+        if (!keepOrder_) {
+            pos = std::lower_bound(members.begin(), members.end(), stringView(key, len),
+                [](const memberType& pr, const stringView& k) { return keyLess(pr.first.data(), pr.first.size(), k.data(), k.size()); });
+        }
+        pos = members.emplace(pos, keyType(key, len, allocator().arena_), json());
+        return inherit(pos->second);
+    }
+    json& json::objectAppend(const char* key, size_t len) {
+        object_->emplace_back(keyType(key, len, allocator().arena_), json());
+        return inherit(object_->back().second);
+    }
+    // members were appended as parsed: sort them unless the order is kept,
+    // and keep only the first member of every key
+    void json::objectFinish() {
+        objectType& members = *object_;
+        if (members.size() < 2) {
+            return;
+        }
+        auto less = [](const memberType& a, const memberType& b) { return a.first < b.first; };
+        if (!keepOrder_) {
+            // often sorted already, such as the output of dump()
+            if (members.size() <= 16) {
+                // insertion sort, stable without the buffer of stable_sort
+                for (size_t i = 1; i < members.size(); ++ i) {
+                    if (less(members[i], members[i - 1])) {
+                        memberType pr(std::piecewise_construct, std::forward_as_tuple(std::move(members[i].first)),
+                            std::forward_as_tuple(std::move(members[i].second), relocate()));
+                        size_t j = i;
+                        for (; j > 0 && less(pr, members[j - 1]); -- j) {
+                            members[j] = std::move(members[j - 1]);
+                        }
+                        members[j] = std::move(pr);
+                    }
+                }
+            } else if (!std::is_sorted(members.begin(), members.end(), less)) {
+                // the order is sorted and then applied a cycle at a time, since stable_sort
+                // would move the members through a buffer of its own, off the arena
+                std::vector<uint32_t> order(members.size());
+                for (size_t i = 0; i < order.size(); ++ i) {
+                    order[i] = (uint32_t)i;
+                }
+                std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return less(members[a], members[b]); });
+                for (size_t i = 0; i < order.size(); ++ i) {
+                    if (order[i] == i) {
+                        continue;
+                    }
+                    memberType pr(std::piecewise_construct, std::forward_as_tuple(std::move(members[i].first)),
+                        std::forward_as_tuple(std::move(members[i].second), relocate()));
+                    size_t j = i;
+                    while (order[j] != i) {
+                        size_t k = order[j];
+                        members[j] = std::move(members[k]);
+                        order[j] = (uint32_t)j;
+                        j = k;
+                    }
+                    members[j] = std::move(pr);
+                    order[j] = (uint32_t)j;
+                }
+            }
+            members.erase(std::unique(members.begin(), members.end(),
+                [](const memberType& a, const memberType& b) { return a.first == b.first; }), members.end());
+            return;
+        }
+        // the order stays, repeated keys are found through a sorted index
+        std::vector<uint32_t> index(members.size());
+        for (size_t i = 0; i < index.size(); ++ i) {
+            index[i] = (uint32_t)i;
+        }
+        std::stable_sort(index.begin(), index.end(), [&](uint32_t a, uint32_t b) { return members[a].first < members[b].first; });
+        std::vector<bool> repeated(members.size(), false);
+        bool any = false;
+        for (size_t i = 1; i < index.size(); ++ i) {
+            if (members[index[i]].first == members[index[i - 1]].first) {
+                repeated[index[i]] = true;
+                any = true;
+            }
+        }
+        if (!any) {
+            return;
+        }
+        size_t kept = 0;
+        for (size_t i = 0; i < members.size(); ++ i) {
+            if (!repeated[i]) {
+                if (kept != i) {
+                    members[kept] = std::move(members[i]);
+                }
+                ++ kept;
+            }
+        }
+        members.erase(members.begin() + kept, members.end());
     }
     bool json::existObjectElement(const std::string& key) {
-        return object_.find(key) != object_.end();
+        if (type_ != JSON_OBJECT) {
+            return false;
+        }
+        return objectFind(key.data(), key.size()) != nullptr;
     }
     json& json::findObjectElement(const std::string& key) { // assert
-        return object_[key];
+        return objectSlot(key.data(), key.size());
     }
     void json::eraseObjectElement(const std::string& key) {
-        object_.erase(key);
+        if (type_ == JSON_OBJECT) {
+            size_t index = objectIndex(key.data(), key.size());
+            if (index != std::string::npos) {
+                object_->erase(object_->begin() + index);
+            }
+        }
     }
-    void json::insertObjectElement(const std::string& key, const json j) {
-        object_.insert({key, j});
+    // the first member with a key wins, as in parseObject
+    void json::insertObjectElement(const std::string& key, const json& j) {
+        json tmp;
+        inherit(tmp).copyValue(j);
+        insertObjectElement(key, std::move(tmp));
     }
-    json& json::operator[](const std::string& key) {
-        if (getType() != json::JSON_OBJECT) {
+    void json::insertObjectElement(const std::string& key, json&& j) {
+        json tmp;
+        inherit(tmp) = std::move(j);
+        if (type_ != JSON_OBJECT) {
             setObject();
         }
-        if (!existObjectElement(key)) {
-            insertObjectElement(key, json());
+        if (objectFind(key.data(), key.size()) == nullptr) {
+            objectSlot(key.data(), key.size()) = std::move(tmp);
         }
-        return findObjectElement(key);
     }
-    json& json::operator[](const char* key) {
-        if (getType() != json::JSON_OBJECT) {
-            setObject();
+    void json::insertObjectElement(std::string&& key, json&& j) {
+        insertObjectElement(static_cast<const std::string&>(key), std::move(j));
+    }
+    json& json::emplaceObjectElement(std::string&& key) {
+        return objectSlot(key.data(), key.size());
+    }
+    stringView json::getObjectKey(size_t index) {
+        return stringView((*object_)[index].first.data(), (*object_)[index].first.size());
+    }
+    json& json::getObjectValue(size_t index) {
+        return (*object_)[index].second;
+    }
+    void json::setKeepOrder(bool keep) {
+        if (keepOrder_ == keep) {
+            return;
         }
-        std::string k(key);
-        if (!existObjectElement(k)) {
-            insertObjectElement(k, json());
+        keepOrder_ = keep;
+        if (!keep && type_ == JSON_OBJECT) {
+            objectFinish();
         }
-        return findObjectElement(k);
+    }
+    json& json::operator[](const std::string& key) {
+        return objectSlot(key.data(), key.size());
+    }
+    template<typename T>
+    json& json::operator[](T* key) {
+        return objectSlot(key, strlen(key));
     }
 
 
@@ -4,6 +4,6 @@ set -e
 
 g++ test_main.cc -o alltest -std=c++14 -lpthread -lgtest
 
-./alltest
+./alltest "$@"
 
 rm -rf ./alltest
\ No newline at end of file
@@ -274,6 +274,36 @@ TEST(AccessTest, AccessString) {
     EXPECT_EQ("hello", j.getString());
 }
 
+TEST(AccessTest, StringView) {
+    using json = xushun::json;
+    json j;
+    EXPECT_EQ(0u, j.getStringView().size());
+    // short strings live in the node, longer ones out of it
+    for (const char* s : {"", "a", "12345678", "123456789", "a string longer than the node"}) {
+        j.setString(s);
+        EXPECT_EQ(xushun::stringView(s), j.getStringView());
+        EXPECT_EQ(strlen(s), j.getStringLength());
+        EXPECT_TRUE(j == s);
+        json copy(j), moved(std::move(copy));
+        EXPECT_TRUE(moved.isEqual(j));
+        EXPECT_EQ("\"" + std::string(s) + "\"", moved.dump());
+    }
+    // embedded '\0' is kept by the view, getString stops at it
+    EXPECT_EQ(json::JSON_PARSE_OK, j.parse("\"a\\u0000b\""));
+    EXPECT_EQ(3u, j.getStringLength());
+    EXPECT_EQ(xushun::stringView("a\0b", 3), j.getStringView());
+    EXPECT_EQ("a", j.getString());
+    EXPECT_EQ(json::JSON_PARSE_OK, j.parse("[\"a long string with a \\u0000 inside\"]"));
+    EXPECT_EQ(29u, j[0].getStringLength());
+    EXPECT_EQ("\"a long string with a \\u0000 inside\"", json(j[0]).dump());
+    // set from a view of itself
+    j.setString("a string longer than the node");
+    j.setString(j.getStringView().toString().substr(2, 6));
+    EXPECT_EQ("string", j.getString());
+    j.setString(std::string(j.getStringView().data() + 1, 3));
+    EXPECT_EQ("tri", j.getString());
+}
+
 TEST(AccessTest, AccessArray) {
     using json = xushun::json;
     json a;
@@ -337,6 +367,11 @@ TEST(AccessTest, AccessArray) {
             EXPECT_DOUBLE_EQ((double)j, a[j].getNumber());
         }
     }
+    // any integer type indexes the array
+    EXPECT_DOUBLE_EQ(0.0, a[0].getNumber());
+    EXPECT_DOUBLE_EQ(1.0, a[1u].getNumber());
+    EXPECT_DOUBLE_EQ(2.0, a[2L].getNumber());
+    EXPECT_DOUBLE_EQ(3.0, a[size_t(3)].getNumber());
 }
 
 TEST(AccessTest, AccessObject) {
@@ -402,6 +437,55 @@ TEST(AccessTest, AccessObject) {
 }
 
 
+TEST(AccessTest, ObjectOrder) {
+    using json = xushun::json;
+    json o;
+    o["b"] = 2.0;
+    o["c"] = 3.0;
+    o["a"] = 1.0;
+    o.insertObjectElement("b", json(9.0)); // the first member wins
+    EXPECT_EQ("{\"a\":1,\"b\":2,\"c\":3}", o.dump());
+    std::string keys;
+    double sum = 0;
+    for (size_t i = 0; i < o.getObjectSize(); ++ i) {
+        keys += o.getObjectKey(i).toString();
+        sum += o.getObjectValue(i).getNumber();
+    }
+    EXPECT_EQ("abc", keys);
+    EXPECT_DOUBLE_EQ(6, sum);
+    EXPECT_EQ(json::JSON_PARSE_OK, o.parse("{\"z\":1,\"y\":{\"q\":1,\"p\":2},\"z\":2}"));
+    EXPECT_EQ("{\"y\":{\"p\":2,\"q\":1},\"z\":1}", o.dump());
+    // insertion order, for parsed and inserted members at any depth
+    json k;
+    k.setKeepOrder(true);
+    EXPECT_EQ(json::JSON_PARSE_OK, k.parse("{\"z\":1,\"y\":{\"q\":1,\"p\":2},\"z\":2}"));
+    k["x"] = 3.0;
+    k["y"]["o"] = 3.0;
+    EXPECT_EQ("{\"z\":1,\"y\":{\"q\":1,\"p\":2,\"o\":3},\"x\":3}", k.dump());
+    json copy = k;
+    EXPECT_EQ(k.dump(), copy.dump());
+    EXPECT_TRUE(copy.isEqual(o) == false && copy["y"].isEqual(k["y"]));
+    copy.eraseObjectElement("z");
+    EXPECT_EQ("{\"y\":{\"q\":1,\"p\":2,\"o\":3},\"x\":3}", copy.dump());
+    copy.setKeepOrder(false);
+    EXPECT_EQ("{\"x\":3,\"y\":{\"q\":1,\"p\":2,\"o\":3}}", copy.dump());
+    // repeated keys in a large object
+    std::string big = "{";
+    for (int i = 0; i < 100; ++ i) {
+        big += "\"k" + std::to_string(99 - i % 50) + "\":" + std::to_string(i) + ",";
+    }
+    big.back() = '}';
+    EXPECT_EQ(json::JSON_PARSE_OK, k.parse(big));
+    EXPECT_EQ(50, k.getObjectSize());
+    EXPECT_EQ("k99", k.getObjectKey(0).toString());
+    EXPECT_DOUBLE_EQ(0, k["k99"].getNumber());
+    EXPECT_DOUBLE_EQ(49, k["k50"].getNumber());
+    EXPECT_EQ(json::JSON_PARSE_OK, o.parse(big));
+    EXPECT_EQ("k50", o.getObjectKey(0).toString());
+    EXPECT_DOUBLE_EQ(49, o["k50"].getNumber());
+    EXPECT_TRUE(o.isEqual(k));
+}
+
 TEST(AccessTest, OperatorType) {
     using json = xushun::json;
     json j;
@@ -418,6 +502,73 @@ TEST(AccessTest, OperatorType) {
     EXPECT_EQ(false, bool(j));
 }
 
+TEST(AccessTest, CompactValue) {
+    using json = xushun::json;
+    // only the active member is stored in the node
+    EXPECT_LE(sizeof(json), 16u);
+    json j;
+    EXPECT_EQ(json::JSON_PARSE_OK, j.parse("{\"a\":[1,\"abc\",{\"b\":null}],\"c\":\"d\"}"));
+    json k = j;
+    k["c"] = 1.0;
+    EXPECT_EQ(json::JSON_STRING, j["c"].getType());
+    EXPECT_EQ("d", j["c"].getString());
+    // assign a value from its own subtree
+    j = j["a"];
+    EXPECT_EQ(json::JSON_ARRAY, j.getType());
+    EXPECT_EQ(3, j.getArraySize());
+    EXPECT_EQ("abc", j[1].getString());
+    j = j[2];
+    EXPECT_EQ(json::JSON_OBJECT, j.getType());
+    EXPECT_EQ(json::JSON_NULL, j["b"].getType());
+    // switching types releases the old member
+    j.setString("abc");
+    j.setNumber(1.0);
+    EXPECT_DOUBLE_EQ(1.0, j.getNumber());
+    EXPECT_EQ("", j.getString());
+    EXPECT_EQ(0, j.getArraySize());
+    EXPECT_EQ(0, j.getObjectSize());
+}
+
+TEST(AccessTest, Move) {
+    using json = xushun::json;
+    json j;
+    EXPECT_EQ(json::JSON_PARSE_OK, j.parse("{\"a\":[1,2,3],\"s\":\"abc\"}"));
+    // move constructor and move assignment leave the source null
+    json k(std::move(j));
+    EXPECT_EQ(json::JSON_NULL, j.getType());
+    EXPECT_EQ(json::JSON_OBJECT, k.getType());
+    EXPECT_EQ(3, k["a"].getArraySize());
+    j = std::move(k);
+    EXPECT_EQ(json::JSON_NULL, k.getType());
+    EXPECT_EQ("abc", j["s"].getString());
+    // move a value out of its own subtree
+    j = std::move(j["a"]);
+    EXPECT_EQ(json::JSON_ARRAY, j.getType());
+    EXPECT_EQ(3, j.getArraySize());
+    // rvalue inserters
+    json e("hello");
+    j.pushbackArray(std::move(e));
+    EXPECT_EQ(json::JSON_NULL, e.getType());
+    EXPECT_EQ("hello", j[3].getString());
+    j.insertArrayElement(0, json(0.0));
+    EXPECT_EQ(5, j.getArraySize());
+    EXPECT_DOUBLE_EQ(0.0, j[0].getNumber());
+    j.pushbackArray(j[4]);
+    EXPECT_EQ("hello", j[5].getString());
+    j.emplacebackArray().setNumber(7.0);
+    EXPECT_DOUBLE_EQ(7.0, j[6].getNumber());
+    json o;
+    std::string key("k");
+    o.insertObjectElement(std::move(key), json(std::string("v")));
+    EXPECT_EQ("v", o["k"].getString());
+    o.emplaceObjectElement("n").setBoolean(true);
+    EXPECT_EQ(json::JSON_TRUE, o["n"].getType());
+    EXPECT_EQ(2, o.getObjectSize());
+    std::string s("moved");
+    o["k"] = std::move(s);
+    EXPECT_EQ("moved", o["k"].getString());
+}
+
 
 
 
@@ -0,0 +1,199 @@
+/*
+*  @Filename : test_arena.hh
+*  @Description : unit test for arena documents
+*  @Datatime : 2026/10/19 10:12:48
+*  @Author : xushun
+*/
+#ifndef  __TEST_ARENA_HH_
+#define  __TEST_ARENA_HH_
+
+
+#include <gtest/gtest.h>
+#include "../json.hh"
+
+
+
+
+
+static const char* arenaTestDoc =
+    "{\"name\":\"a string that is too long for the small buffer\",\"n\":[1,2,3,[4,[5]]],"
+    "\"o\":{\"k\":\"v\\n\",\"t\":true,\"f\":false,\"z\":null},\"n\":\"duplicate\"}";
+
+TEST(ArenaTest, Parse) {
+    using json = xushun::json;
+    json heap, doc;
+    EXPECT_FALSE(doc.isArena());
+    EXPECT_TRUE(doc.setArena());
+    EXPECT_TRUE(doc.isArena());
+    EXPECT_EQ(json::JSON_PARSE_OK, heap.parse(arenaTestDoc));
+    EXPECT_EQ(json::JSON_PARSE_OK, doc.parse(arenaTestDoc));
+    EXPECT_EQ(heap.dump(), doc.dump());
+    EXPECT_TRUE(doc.isEqual(heap));
+    // a node below the root is in the arena but does not own one
+    EXPECT_TRUE(doc["o"].isArena());
+    EXPECT_FALSE(doc["o"].setArena());
+    EXPECT_TRUE(doc.setArena());
+    // the arena is reused by the next parse
+    for (int i = 0; i < 3; ++ i) {
+        EXPECT_EQ(json::JSON_PARSE_OK, doc.parse(arenaTestDoc));
+        EXPECT_EQ(heap.dump(), doc.dump());
+    }
+    EXPECT_EQ(json::JSON_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, doc.parse("[1,[2,\"long string in a failed parse\"}"));
+    EXPECT_EQ(json::JSON_NULL, doc.getType());
+    // the value set before setArena is kept
+    json keep("a string that is too long for the small buffer");
+    keep.setArena();
+    EXPECT_EQ("a string that is too long for the small buffer", keep.getString());
+}
+
+TEST(ArenaTest, Modify) {
+    using json = xushun::json;
+    json doc;
+    doc.setArena();
+    doc.parse(arenaTestDoc);
+    json heap;
+    heap.parse(arenaTestDoc);
+    // values from the heap are copied into the arena
+    json outside("another string that is too long for the small buffer");
+    doc["n"].pushbackArray(outside);
+    doc["n"].pushbackArray(json(std::vector<double>{7, 8}));
+    doc["n"].insertArrayElement(0, std::move(outside));
+    doc["o"]["new key that is too long for the small buffer"] = "x";
+    doc["o"]["k"] = heap["o"];
+    doc["o"].insertObjectElement("h", heap);
+    doc["n"].pushbackArray(doc["n"][4]);
+    doc["n"].eraseArrayElement(1, 1);
+    EXPECT_EQ("[\"another string that is too long for the small buffer\",2,3,[4,[5]],"
+        "\"another string that is too long for the small buffer\",[7,8],[4,[5]]]", doc["n"].dump());
+    EXPECT_TRUE(doc["o"]["h"].isEqual(heap));
+    EXPECT_TRUE(doc["o"]["k"].isEqual(heap["o"]));
+    // copies leave the document
+    json copy = doc["o"];
+    json assigned;
+    assigned = doc["n"];
+    std::string dumped = copy.dump() + assigned.dump();
+    doc.setNull();
+    EXPECT_EQ(dumped, copy.dump() + assigned.dump());
+}
+
+TEST(ArenaTest, Move) {
+    using json = xushun::json;
+    json doc;
+    doc.setArena();
+    doc.parse(arenaTestDoc);
+    std::string dumped = doc.dump();
+    // the document changes hands without a copy
+    json moved(std::move(doc));
+    EXPECT_EQ(json::JSON_NULL, doc.getType());
+    json assigned;
+    assigned = std::move(moved);
+    EXPECT_EQ(dumped, assigned.dump());
+    // doc is an ordinary node again
+    doc.parse("[\"a string that is too long for the small buffer\"]");
+    std::vector<json> docs;
+    docs.push_back(std::move(assigned));
+    docs.push_back(std::move(doc));
+    EXPECT_EQ(dumped, docs[0].dump());
+    // a document assigned into an arena node is copied
+    json other;
+    other.setArena();
+    other.parse("{}");
+    other["d"] = std::move(docs[0]);
+    EXPECT_EQ(dumped, other["d"].dump());
+    docs.clear();
+    EXPECT_EQ(dumped, other["d"].dump());
+}
+
+TEST(ArenaTest, MoveChildOut) {
+    using json = xushun::json;
+    json* doc = new json;
+    doc->setArena();
+    doc->parse(arenaTestDoc);
+    std::string n = (*doc)["n"].dump(), o = (*doc)["o"].dump();
+    // nodes moved out of the document are copied to the heap and outlive it
+    json* moved = new json(std::move((*doc)["n"]));
+    EXPECT_EQ(n, (*doc)["n"].dump()); // a copy, the child keeps its value
+    std::vector<json> nodes;
+    nodes.push_back(std::move((*doc)["o"]));
+    nodes.push_back(std::move((*doc)["name"]));
+    json assigned;
+    assigned = std::move((*doc)["o"]["k"]);
+    // the document itself is still whole after a sort that relocates its members
+    (*doc)["o"].parse("{\"y\":[1],\"b\":[2],\"x\":{},\"a\":\"a string longer than a node\",\"c\":3,\"d\":4,"
+                      "\"e\":5,\"f\":6,\"g\":7,\"h\":8,\"i\":9,\"j\":10,\"k\":11,\"l\":12,\"m\":13,\"n\":14,\"o\":15}");
+    EXPECT_EQ("{\"a\":\"a string longer than a node\",\"b\":[2],\"c\":3,\"d\":4,\"e\":5,\"f\":6,\"g\":7,\"h\":8,"
+              "\"i\":9,\"j\":10,\"k\":11,\"l\":12,\"m\":13,\"n\":14,\"o\":15,\"x\":{},\"y\":[1]}", (*doc)["o"].dump());
+    delete doc;
+    EXPECT_EQ(n, moved->dump());
+    moved->pushbackArray(json("grown after the document is gone"));
+    EXPECT_EQ(5u, moved->getArraySize());
+    delete moved;
+    nodes.emplace_back(json(2.0));
+    EXPECT_EQ(o, nodes[0].dump());
+    EXPECT_EQ("\"a string that is too long for the small buffer\"", nodes[1].dump());
+    EXPECT_EQ("\"v\\n\"", assigned.dump());
+    nodes[0]["k"].setString("a string that is too long for the small buffer");
+    EXPECT_EQ("\"a string that is too long for the small buffer\"", nodes[0]["k"].dump());
+}
+
+TEST(ArenaTest, Alias) {
+    using json = xushun::json;
+    json heap;
+    heap.parse(arenaTestDoc);
+    json doc;
+    doc.setArena();
+    doc.parse(arenaTestDoc);
+    doc["o"] = doc;
+    heap["o"] = heap;
+    EXPECT_EQ(heap.dump(), doc.dump());
+    doc = doc["o"]["n"];
+    heap = heap["o"]["n"];
+    EXPECT_EQ(heap.dump(), doc.dump());
+    doc = std::move(doc[3]);
+    heap = std::move(heap[3]);
+    EXPECT_EQ(heap.dump(), doc.dump());
+    doc[1] = std::move(doc);
+    EXPECT_EQ("[4,[4,[5]]]", doc.dump());
+}
+
+TEST(ArenaTest, Stream) {
+    using json = xushun::json;
+    json doc;
+    doc.setArena();
+    json::streamParser parser(doc);
+    std::string s(arenaTestDoc);
+    for (size_t i = 0; i < s.size(); i += 5) {
+        EXPECT_EQ(json::JSON_PARSE_OK, parser.feed(s.data() + i, std::min<size_t>(5, s.size() - i)));
+    }
+    EXPECT_EQ(json::JSON_PARSE_OK, parser.finish());
+    json heap;
+    heap.parse(arenaTestDoc);
+    EXPECT_EQ(heap.dump(), doc.dump());
+}
+
+TEST(ArenaTest, InternKeys) {
+    using json = xushun::json;
+    const char* records =
+        "[{\"a key longer than fifteen\":1,\"id\":2},{\"id\":3,\"a key longer than fifteen\":4},"
+        "{\"a key longer than fifteen\":5,\"another long key of a record\":6}]";
+    json heap, doc;
+    doc.setArena();
+    EXPECT_EQ(json::JSON_PARSE_OK, heap.parse(records));
+    EXPECT_EQ(json::JSON_PARSE_OK, doc.parse(records));
+    EXPECT_EQ(heap.dump(), doc.dump());
+    EXPECT_TRUE(doc.isEqual(heap));
+    // one copy of a long key per document
+    EXPECT_EQ(doc[0].getObjectKey(0).data(), doc[1].getObjectKey(0).data());
+    EXPECT_EQ(doc[0].getObjectKey(0).data(), doc[2].getObjectKey(0).data());
+    EXPECT_NE(heap[0].getObjectKey(0).data(), heap[1].getObjectKey(0).data());
+    EXPECT_EQ(6.0, doc[2]["another long key of a record"].getNumber());
+    // keys inserted later are pooled too, copies out of the document own their keys
+    doc[1]["another long key of a record"] = 7.0;
+    EXPECT_EQ(doc[1].getObjectKey(1).data(), doc[2].getObjectKey(1).data());
+    json copy = doc[1];
+    doc.parse("[]");
+    EXPECT_EQ("{\"a key longer than fifteen\":4,\"another long key of a record\":7,\"id\":3}", copy.dump());
+}
+
+
+#endif // __TEST_ARENA_HH_
@@ -0,0 +1,197 @@
+/*
+*  @Filename : test_cbor.hh
+*  @Description : unit test for the CBOR encoder and decoder
+*  @Datatime : 2026/10/21 15:42:19
+*  @Author : xushun
+*/
+#ifndef  __TEST_CBOR_HH_
+#define  __TEST_CBOR_HH_
+
+
+#include <gtest/gtest.h>
+#include "../json.hh"
+#include "test_sax.hh"
+
+
+
+
+
+static std::string cborBytes(std::initializer_list<int> bytes) {
+    std::string s;
+    for (int b : bytes) { s += (char)b; }
+    return s;
+}
+
+#define TEST_CBOR_ROUNDTRIP(jsonString)\
+    do {\
+        json j, back;\
+        EXPECT_EQ(json::JSON_PARSE_OK, j.parse(jsonString));\
+        std::string bytes = j.dumpCbor();\
+        EXPECT_EQ(json::JSON_PARSE_OK, back.parseCbor(xushun::stringView(bytes)));\
+        EXPECT_TRUE(back.isEqual(j)) << jsonString;\
+        EXPECT_EQ(j.dump(), back.dump());\
+    } while(0)
+
+#define TEST_CBOR_ENCODE(expect, jsonString)\
+    do {\
+        json j;\
+        EXPECT_EQ(json::JSON_PARSE_OK, j.parse(jsonString));\
+        EXPECT_EQ(expect, j.dumpCbor()) << jsonString;\
+    } while(0)
+
+#define TEST_CBOR_DECODE(expect, bytes)\
+    do {\
+        json j;\
+        std::string s(bytes);\
+        EXPECT_EQ(json::JSON_PARSE_OK, j.parseCbor(xushun::stringView(s)));\
+        EXPECT_EQ(expect, j.dump());\
+    } while(0)
+
+#define TEST_CBOR_ERROR(error, bytes)\
+    do {\
+        json j;\
+        recordHandler h;\
+        std::string s(bytes);\
+        j = 1.0;\
+        EXPECT_EQ(error, j.parseCbor(xushun::stringView(s)));\
+        EXPECT_EQ(json::JSON_NULL, j.getType());\
+        EXPECT_EQ(error, json::parseCbor(s.data(), s.size(), h));\
+    } while(0)
+
+TEST(CborTest, RoundTrip) {
+    using json = xushun::json;
+    TEST_CBOR_ROUNDTRIP("null");
+    TEST_CBOR_ROUNDTRIP("false");
+    TEST_CBOR_ROUNDTRIP("true");
+    TEST_CBOR_ROUNDTRIP("0");
+    TEST_CBOR_ROUNDTRIP("-0");
+    TEST_CBOR_ROUNDTRIP("0.1");
+    TEST_CBOR_ROUNDTRIP("-1.5e-300");
+    TEST_CBOR_ROUNDTRIP("1.7976931348623157e308");
+    TEST_CBOR_ROUNDTRIP("9007199254740992");
+    TEST_CBOR_ROUNDTRIP("-9007199254740992");
+    TEST_CBOR_ROUNDTRIP("18446744073709551616");
+    TEST_CBOR_ROUNDTRIP("\"\"");
+    TEST_CBOR_ROUNDTRIP("\"short\"");
+    TEST_CBOR_ROUNDTRIP("\"a\\u0000b and a string longer than the inline storage\"");
+    TEST_CBOR_ROUNDTRIP("[]");
+    TEST_CBOR_ROUNDTRIP("{}");
+    TEST_CBOR_ROUNDTRIP("[null,false,true,123,-4.25,\"abc\",[1,[2,[3]]],{\"k\":{}}]");
+    TEST_CBOR_ROUNDTRIP("{\"n\":null,\"a key longer than fifteen chars\":[1,2],\"o\":{\"x\":\"y\"},\"\":0}");
+    std::string big = "[";
+    for (int i = 0; i < 70000; ++ i) {
+        big += (i > 0 ? "," : "") + std::to_string(i * 31);
+    }
+    TEST_CBOR_ROUNDTRIP(big + "]");
+    // into an arena document
+    json j, doc;
+    j.parse("{\"records\":[{\"id\":1,\"name\":\"a name past eight\"}]}");
+    doc.setArena();
+    EXPECT_EQ(json::JSON_PARSE_OK, doc.parseCbor(xushun::stringView(j.dumpCbor())));
+    EXPECT_TRUE(doc.isEqual(j));
+    // appends
+    std::string out = "x";
+    j.dumpCbor(out);
+    EXPECT_EQ("x" + j.dumpCbor(), out);
+}
+
+TEST(CborTest, Encode) {
+    using json = xushun::json;
+    // RFC 8949 appendix A
+    TEST_CBOR_ENCODE(cborBytes({0x00}), "0");
+    TEST_CBOR_ENCODE(cborBytes({0x17}), "23");
+    TEST_CBOR_ENCODE(cborBytes({0x18, 0x18}), "24");
+    TEST_CBOR_ENCODE(cborBytes({0x18, 0x64}), "100");
+    TEST_CBOR_ENCODE(cborBytes({0x19, 0x03, 0xe8}), "1000");
+    TEST_CBOR_ENCODE(cborBytes({0x1a, 0x00, 0x0f, 0x42, 0x40}), "1000000");
+    TEST_CBOR_ENCODE(cborBytes({0x1b, 0x00, 0x00, 0x00, 0xe8, 0xd4, 0xa5, 0x10, 0x00}), "1000000000000");
+    TEST_CBOR_ENCODE(cborBytes({0x20}), "-1");
+    TEST_CBOR_ENCODE(cborBytes({0x38, 0x63}), "-100");
+    TEST_CBOR_ENCODE(cborBytes({0x39, 0x03, 0xe7}), "-1000");
+    TEST_CBOR_ENCODE(cborBytes({0xfb, 0x3f, 0xf1, 0x99, 0x99, 0x99, 0x99, 0x99, 0x9a}), "1.1");
+    TEST_CBOR_ENCODE(cborBytes({0xfb, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}), "-0.0");
+    TEST_CBOR_ENCODE(cborBytes({0xf4}), "false");
+    TEST_CBOR_ENCODE(cborBytes({0xf5}), "true");
+    TEST_CBOR_ENCODE(cborBytes({0xf6}), "null");
+    TEST_CBOR_ENCODE(cborBytes({0x60}), "\"\"");
+    TEST_CBOR_ENCODE(cborBytes({0x61, 0x61}), "\"a\"");
+    TEST_CBOR_ENCODE(cborBytes({0x64, 0x49, 0x45, 0x54, 0x46}), "\"IETF\"");
+    TEST_CBOR_ENCODE(cborBytes({0x80}), "[]");
+    TEST_CBOR_ENCODE(cborBytes({0x83, 0x01, 0x82, 0x02, 0x03, 0x82, 0x04, 0x05}), "[1,[2,3],[4,5]]");
+    TEST_CBOR_ENCODE(cborBytes({0xa0}), "{}");
+    TEST_CBOR_ENCODE(cborBytes({0xa2, 0x61, 0x61, 0x01, 0x61, 0x62, 0x82, 0x02, 0x03}), "{\"a\":1,\"b\":[2,3]}");
+}
+
+TEST(CborTest, Decode) {
+    using json = xushun::json;
+    // other encoders' choices
+    TEST_CBOR_DECODE("1", cborBytes({0x18, 0x01}));
+    TEST_CBOR_DECODE("4294967296", cborBytes({0x1b, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00}));
+    TEST_CBOR_DECODE("-1.8446744073709552e+19", cborBytes({0x3b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}));
+    TEST_CBOR_DECODE("1", cborBytes({0xf9, 0x3c, 0x00}));
+    TEST_CBOR_DECODE("-4", cborBytes({0xf9, 0xc4, 0x00}));
+    TEST_CBOR_DECODE("5.960464477539063e-08", cborBytes({0xf9, 0x00, 0x01}));
+    TEST_CBOR_DECODE("65504", cborBytes({0xf9, 0x7b, 0xff}));
+    TEST_CBOR_DECODE("100000", cborBytes({0xfa, 0x47, 0xc3, 0x50, 0x00}));
+    TEST_CBOR_DECODE("1", cborBytes({0xfb, 0x3f, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}));
+    TEST_CBOR_DECODE("\"abc\"", cborBytes({0x78, 0x03, 0x61, 0x62, 0x63}));
+    // the first member with a key wins, as in parse()
+    TEST_CBOR_DECODE("{\"a\":1}", cborBytes({0xa2, 0x61, 0x61, 0x01, 0x61, 0x61, 0x02}));
+}
+
+TEST(CborTest, Error) {
+    using json = xushun::json;
+    TEST_CBOR_ERROR(json::JSON_PARSE_EXPECT_VALUE, "");
+    TEST_CBOR_ERROR(json::JSON_PARSE_ROOT_NOT_SINGULAR, cborBytes({0xf6, 0xf6}));
+    TEST_CBOR_ERROR(json::JSON_PARSE_INVALID_VALUE, cborBytes({0xf7}));                   // undefined
+    TEST_CBOR_ERROR(json::JSON_PARSE_INVALID_VALUE, cborBytes({0xf8, 0x20}));             // simple value
+    TEST_CBOR_ERROR(json::JSON_PARSE_INVALID_VALUE, cborBytes({0x41, 0x00}));             // byte string
+    TEST_CBOR_ERROR(json::JSON_PARSE_INVALID_VALUE, cborBytes({0xc1, 0x00}));             // tag
+    TEST_CBOR_ERROR(json::JSON_PARSE_INVALID_VALUE, cborBytes({0x9f, 0xff}));             // indefinite array
+    TEST_CBOR_ERROR(json::JSON_PARSE_INVALID_VALUE, cborBytes({0x1c}));                   // reserved
+    TEST_CBOR_ERROR(json::JSON_PARSE_INVALID_VALUE, cborBytes({0xf9, 0x7e, 0x00}));       // NaN
+    TEST_CBOR_ERROR(json::JSON_PARSE_NUMBER_TOO_BIG, cborBytes({0xf9, 0xfc, 0x00}));      // -Infinity
+    TEST_CBOR_ERROR(json::JSON_PARSE_MISS_KEY, cborBytes({0xa1, 0x01, 0x01}));
+    TEST_CBOR_ERROR(json::JSON_PARSE_MISS_KEY, cborBytes({0x81, 0xa1, 0x81, 0x01, 0x01}));
+    TEST_CBOR_ERROR(json::JSON_PARSE_BINARY_TRUNCATED, cborBytes({0x9b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}));
+    TEST_CBOR_ERROR(json::JSON_PARSE_BINARY_TRUNCATED, cborBytes({0x7b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}));
+    // cut anywhere
+    json j;
+    j.parse("{\"a\":[1,-1000,1.5,\"a string longer than eight\",{\"k\":null}],\"b\":true}");
+    std::string bytes = j.dumpCbor();
+    for (size_t len = 1; len < bytes.size(); ++ len) {
+        TEST_CBOR_ERROR(json::JSON_PARSE_BINARY_TRUNCATED, bytes.substr(0, len));
+    }
+}
+
+TEST(CborTest, Events) {
+    using json = xushun::json;
+    json j;
+    j.parse("{\"k\":[null,true,1.5,\"a string longer than eight\"],\"o\":{}}");
+    std::string bytes = j.dumpCbor();
+    recordHandler h;
+    EXPECT_EQ(json::JSON_PARSE_OK, json::parseCbor(bytes.data(), bytes.size(), h));
+    EXPECT_EQ("{ k:k [ n t 1.5 s:a string longer than eight ]4 k:o { }0 }2 ", h.events);
+    // strings are views into the buffer
+    struct viewHandler : json::handler {
+        const char* begin;
+        const char* end;
+        bool inside = true;
+        bool string(const xushun::stringView& str) override {
+            inside = inside && str.data() >= begin && str.data() + str.size() <= end;
+            return true;
+        }
+    } v;
+    v.begin = bytes.data();
+    v.end = bytes.data() + bytes.size();
+    EXPECT_EQ(json::JSON_PARSE_OK, json::parseCbor(bytes.data(), bytes.size(), v));
+    EXPECT_TRUE(v.inside);
+    // a handler stops the parse
+    recordHandler stop;
+    stop.limit = 3;
+    EXPECT_EQ(json::JSON_PARSE_TERMINATED, json::parseCbor(bytes.data(), bytes.size(), stop));
+    EXPECT_EQ("{ k:k [ ", stop.events);
+}
+
+
+#endif // __TEST_CBOR_HH_
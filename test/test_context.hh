@@ -0,0 +1,67 @@
+/*
+*  @Filename : test_context.hh
+*  @Description : unit test for the reusable parser and serializer
+*  @Datatime : 2026/10/22 14:12:50
+*  @Author : xushun
+*/
+#ifndef  __TEST_CONTEXT_HH_
+#define  __TEST_CONTEXT_HH_
+
+
+#include <gtest/gtest.h>
+#include "../json.hh"
+#include "test_sax.hh"
+
+
+
+
+
+TEST(ContextTest, Parser) {
+    using json = xushun::json;
+    const char* docs[] = {
+        "{\"a\" : [1, -2.5e3, \"x\\\"y\\\\\"], \"b\" : {\"c\" : null, \"d\" : [true, false, {}]}}",
+        "[1,]", "\"\\u4e2d\\n\"", "{\"a\":1", "[[[]]]", "null x", "  [\"a long string, longer than a node\"]  ",
+        "{\"k\\u00e9y\":{\"k\":{\"k\":[\"\\t\"]}}}", "", "1e309", "[{\"a\":[{\"b\":[]}]}]",
+    };
+    // one parser for all of them, errors in between leave nothing behind
+    json::parser parser;
+    for (int round = 0; round < 3; ++ round) {
+        for (const char* doc : docs) {
+            std::string s(doc);
+            json expect, j;
+            j.setBoolean(true);
+            EXPECT_EQ(expect.parse(s), parser.parse(j, s.data(), s.size())) << s;
+            EXPECT_EQ(expect.dump(), j.dump()) << s;
+            recordHandler h1, h2;
+            EXPECT_EQ(json::parse(s.data(), s.size(), h1), parser.parse(s.data(), s.size(), h2)) << s;
+            EXPECT_EQ(h1.events, h2.events) << s;
+        }
+    }
+    // an arena document, and the depth limit
+    json doc;
+    doc.setArena();
+    EXPECT_EQ(json::JSON_PARSE_OK, parser.parse(doc, xushun::stringView(docs[0])));
+    EXPECT_EQ(0u, doc["b"]["d"][2].getObjectSize());
+    json j;
+    EXPECT_EQ(json::JSON_PARSE_DEPTH_EXCEEDED, parser.parse(j, xushun::stringView(std::string(100000, '['))));
+    EXPECT_EQ(json::JSON_PARSE_OK, parser.parse(j, xushun::stringView(docs[4])));
+    EXPECT_EQ("[[[]]]", j.dump());
+}
+
+TEST(ContextTest, Serializer) {
+    using json = xushun::json;
+    json::serializer serializer;
+    json a, b;
+    a.parse("{\"a\":[1,\"x\\\"y\"],\"b\":{\"c\":null}}");
+    b.parse("[\"a long string, longer than a node\",[[]],{}]");
+    for (int round = 0; round < 3; ++ round) {
+        const std::string& text = serializer.dump(a);
+        EXPECT_EQ(a.dump(), text);
+        EXPECT_EQ(b.dump(), serializer.dump(b));
+        json c(3.5);
+        EXPECT_EQ("3.5", serializer.dump(c));
+    }
+}
+
+
+#endif // __TEST_CONTEXT_HH_
@@ -0,0 +1,107 @@
+/*
+*  @Filename : test_depth.hh
+*  @Description : unit test for deep nesting and the depth limit
+*  @Datatime : 2026/10/21 19:47:12
+*  @Author : xushun
+*/
+#ifndef  __TEST_DEPTH_HH_
+#define  __TEST_DEPTH_HH_
+
+
+#include <gtest/gtest.h>
+#include "../json.hh"
+#include "test_stream.hh"
+
+
+
+
+
+// every parser gives the same error for the text, and CBOR for the same nesting
+#define TEST_DEPTH(error, jsonString, cborString)\
+    do {\
+        std::string s(jsonString), c(cborString);\
+        json j;\
+        json::handler h;\
+        EXPECT_EQ(error, j.parse(s));\
+        EXPECT_EQ(error, json::parse(s.data(), s.size(), h));\
+        EXPECT_EQ(error, j.parseIndexed(s));\
+        EXPECT_EQ(error, json::parseIndexed(s.data(), s.size(), h));\
+        EXPECT_EQ(error, streamParse(j, s, s.size() / 2, 4096));\
+        json::lazyValue lazy;\
+        EXPECT_EQ(error, lazy.parse(s.data(), s.size()));\
+        EXPECT_EQ(error, j.parseCbor(c.data(), c.size()));\
+        EXPECT_EQ(error, json::parseCbor(c.data(), c.size(), h));\
+    } while(0)
+
+std::string nestedArrays(size_t depth) {
+    return std::string(depth, '[') + std::string(depth, ']');
+}
+std::string nestedObjects(size_t depth) {
+    std::string s;
+    for (size_t i = 0; i < depth; ++ i) { s += "{\"a\":"; }
+    return s + "0" + std::string(depth, '}');
+}
+
+TEST(DepthTest, Exceeded) {
+    using json = xushun::json;
+    EXPECT_EQ(1000u, json::getMaxDepth());
+    const size_t deep = 1000000;
+    // hostile input, closed or not
+    TEST_DEPTH(json::JSON_PARSE_DEPTH_EXCEEDED, std::string(deep, '['), std::string(deep, '\x81'));
+    TEST_DEPTH(json::JSON_PARSE_DEPTH_EXCEEDED, nestedArrays(deep), std::string(deep, '\x81') + '\x80');
+    std::string cbor;
+    for (size_t i = 0; i < deep; ++ i) { cbor += "\xa1\x61\x61"; }
+    TEST_DEPTH(json::JSON_PARSE_DEPTH_EXCEEDED, nestedObjects(deep), cbor + '\x00');
+    // the tree is left null
+    json j;
+    j.setBoolean(true);
+    EXPECT_EQ(json::JSON_PARSE_DEPTH_EXCEEDED, j.parse(nestedObjects(deep)));
+    EXPECT_EQ(json::JSON_NULL, j.getType());
+}
+
+TEST(DepthTest, Limit) {
+    using json = xushun::json;
+    json::setMaxDepth(3);
+    TEST_DEPTH(json::JSON_PARSE_OK, "[[[1]]]", "\x81\x81\x81\x01");
+    TEST_DEPTH(json::JSON_PARSE_OK, "[[[]], {\"a\": {}}]", "\x82\x81\x80\xa1\x61\x61\xa0");
+    TEST_DEPTH(json::JSON_PARSE_DEPTH_EXCEEDED, "[[[[]]]]", "\x81\x81\x81\x80");
+    TEST_DEPTH(json::JSON_PARSE_DEPTH_EXCEEDED, "[1, {\"a\": [{}]}]", "\x82\x01\xa1\x61\x61\x81\xa0");
+    json::setMaxDepth(0);
+    TEST_DEPTH(json::JSON_PARSE_OK, "\"a\"", "\x61\x61");
+    TEST_DEPTH(json::JSON_PARSE_DEPTH_EXCEEDED, "[]", "\x80");
+    json::setMaxDepth(1000);
+    TEST_DEPTH(json::JSON_PARSE_OK, nestedArrays(1000), std::string(999, '\x81') + '\x80');
+    TEST_DEPTH(json::JSON_PARSE_DEPTH_EXCEEDED, nestedArrays(1001), std::string(1000, '\x81') + '\x80');
+}
+
+TEST(DepthTest, DeepTree) {
+    using json = xushun::json;
+    // deeper than the C++ stack would take, dumped, compared, copied and freed all the same
+    const size_t deep = 200000;
+    json::setMaxDepth(deep);
+    std::string arrays = nestedArrays(deep), objects = nestedObjects(deep);
+    json a, b;
+    EXPECT_EQ(json::JSON_PARSE_OK, a.parse(arrays));
+    EXPECT_EQ(json::JSON_PARSE_OK, b.parseIndexed(objects));
+    EXPECT_EQ(arrays, a.dump());
+    EXPECT_EQ(objects, b.dump());
+    json c(b);
+    EXPECT_TRUE(c.isEqual(b));
+    EXPECT_FALSE(a.isEqual(b));
+    json d;
+    EXPECT_EQ(json::JSON_PARSE_OK, d.parseCbor(xushun::stringView(c.dumpCbor())));
+    EXPECT_TRUE(d.isEqual(b));
+    // one leaf differs at the bottom
+    objects[objects.size() - deep - 1] = '1';
+    EXPECT_EQ(json::JSON_PARSE_OK, d.parse(objects));
+    EXPECT_FALSE(d.isEqual(b));
+    // and in an arena document
+    json e;
+    e.setArena();
+    EXPECT_EQ(json::JSON_PARSE_OK, e.parse(arrays));
+    EXPECT_TRUE(e.isEqual(a));
+    json::setMaxDepth(1000);
+}
+
+
+#endif // __TEST_DEPTH_HH_
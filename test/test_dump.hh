@@ -11,6 +11,8 @@
 
 
 #include <gtest/gtest.h>
+#include <sstream>
+#include <unistd.h>
 #include "../json.hh"
 
 
@@ -39,16 +41,44 @@ TEST(DumpTest, DumpNumber) {
     TEST_ROUNDTRIP("1.234e+20");
     TEST_ROUNDTRIP("1.234e-20");
     TEST_ROUNDTRIP("1.0000000000000002"); /* the smallest number > 1 */
-    TEST_ROUNDTRIP("4.9406564584124654e-324"); /* minimum denormal */
-    TEST_ROUNDTRIP("-4.9406564584124654e-324");
-    TEST_ROUNDTRIP("2.2250738585072009e-308");  /* Max subnormal double */
-    TEST_ROUNDTRIP("-2.2250738585072009e-308");
+    TEST_ROUNDTRIP("5e-324"); /* minimum denormal */
+    TEST_ROUNDTRIP("-5e-324");
+    TEST_ROUNDTRIP("2.225073858507201e-308");  /* Max subnormal double */
+    TEST_ROUNDTRIP("-2.225073858507201e-308");
     TEST_ROUNDTRIP("2.2250738585072014e-308");  /* Min normal positive double */
     TEST_ROUNDTRIP("-2.2250738585072014e-308");
     TEST_ROUNDTRIP("1.7976931348623157e+308");  /* Max double */
     TEST_ROUNDTRIP("-1.7976931348623157e+308");
 }
 
+#define TEST_DUMP(expectString, jsonString)\
+    do {\
+        json j;\
+        EXPECT_EQ(json::JSON_PARSE_OK, j.parse(jsonString));\
+        EXPECT_EQ(expectString, j.dump());\
+    } while(0)
+
+TEST(DumpTest, DumpNumberShortest) {
+    using json = xushun::json;
+    // shortest digits that read back to the same double
+    TEST_DUMP("0.1", "0.1");
+    TEST_DUMP("0.1", "0.10000000000000001");
+    TEST_DUMP("0.3", "0.3");
+    TEST_DUMP("0.30000000000000004", "0.30000000000000004");
+    TEST_DUMP("0.3333333333333333", "0.33333333333333333");
+    TEST_DUMP("5e-324", "4.9406564584124654e-324");
+    TEST_DUMP("123.456", "1.23456e2");
+    // exponent layout follows %.17g
+    TEST_DUMP("0.0001", "1e-4");
+    TEST_DUMP("1e-05", "1e-5");
+    TEST_DUMP("10000000000000000", "1e16");
+    TEST_DUMP("1e+17", "1e17");
+    TEST_DUMP("9007199254740991", "9007199254740991");
+    TEST_DUMP("-123456789", "-123456789");
+    TEST_DUMP("-0", "-0.0");
+    TEST_DUMP("[0.5,-2.5e-10,100]", "[0.5,-2.5e-10,1e2]");
+}
+
 TEST(DumpTest, DumpString) {
     using json = xushun::json;
     TEST_ROUNDTRIP("\"\"");
@@ -60,6 +90,29 @@ TEST(DumpTest, DumpString) {
     // TEST_ROUNDTRIP("\"\\ud834\\udd1e\"");
 }
 
+// long clean spans around every char that needs escaping
+TEST(DumpTest, DumpLongString) {
+    using json = xushun::json;
+    const char* escaped[32] = {
+        "\\u0000", "\\u0001", "\\u0002", "\\u0003", "\\u0004", "\\u0005", "\\u0006", "\\u0007",
+        "\\b",     "\\t",     "\\n",     "\\u000B", "\\f",     "\\r",     "\\u000E", "\\u000F",
+        "\\u0010", "\\u0011", "\\u0012", "\\u0013", "\\u0014", "\\u0015", "\\u0016", "\\u0017",
+        "\\u0018", "\\u0019", "\\u001A", "\\u001B", "\\u001C", "\\u001D", "\\u001E", "\\u001F"
+    };
+    for (size_t len = 0; len < 70; len += 3) {
+        std::string plain;
+        for (size_t i = 0; i < len; ++ i) { plain += (char)('a' + i % 26); }
+        json j(plain);
+        EXPECT_EQ("\"" + plain + "\"", j.dump());
+        for (int ch = 0; ch < 0x20; ++ ch) {
+            j.setString(plain + (char)ch + "\xE2\x82\xAC" + plain);
+            EXPECT_EQ("\"" + plain + escaped[ch] + "\xE2\x82\xAC" + plain + "\"", j.dump());
+        }
+        j.setString(plain + "\"" + plain + "\\");
+        EXPECT_EQ("\"" + plain + "\\\"" + plain + "\\\\\"", j.dump());
+    }
+}
+
 TEST(DumpTest, DumpArray) {
     using json = xushun::json;
     TEST_ROUNDTRIP("[]");
@@ -73,6 +126,158 @@ TEST(DumpTest, DumpObject) {
     // TEST_ROUNDTRIP("{\"n\":null,\"f\":false,\"t\":true,\"i\":123,\"s\":\"abc\",\"a\":[1,2,3],\"o\":{\"1\":1,\"2\":2,\"3\":3}}");
 }
 
+TEST(DumpTest, DumpRepeat) {
+    using json = xushun::json;
+    json j;
+    j.parse("{\"a\":[1,\"x\"],\"b\":null}");
+    std::string first = j.dump();
+    EXPECT_EQ(first, j.dump());
+    EXPECT_EQ(first, j.dump());
+}
+
+TEST(DumpTest, Writer) {
+    using json = xushun::json;
+    // more than a few blocks, with strings longer than a block and escapes across block ends
+    json j;
+    j.setArray();
+    for (int i = 0; i < 3000; ++ i) {
+        json record;
+        record["id"] = (double)i;
+        record["text"] = std::string(i % 97, 'x') + "\"\n" + std::to_string(i);
+        j.pushbackArray(record);
+    }
+    j.pushbackArray(json(std::string(200000, 'y')));
+    j.pushbackArray(json(std::string(70000, '\n')));
+    std::string expect = j.dump();
+
+    std::ostringstream os;
+    {
+        json::writer out(os);
+        EXPECT_TRUE(out.write(j));
+        EXPECT_TRUE(out.write("\n", 1));
+        EXPECT_TRUE(out.write(j));
+    }
+    EXPECT_EQ(expect + "\n" + expect, os.str());
+
+    // blocks of at most 64KB reach the sink
+    std::string called;
+    size_t largest = 0, calls = 0;
+    {
+        json::writer out([&](const char* data, size_t len) {
+            called.append(data, len);
+            largest = std::max(largest, len);
+            ++ calls;
+            return true;
+        });
+        EXPECT_TRUE(out.write(j));
+        EXPECT_TRUE(out.flush());
+        EXPECT_EQ(expect.size(), out.size());
+    }
+    EXPECT_EQ(expect, called);
+    EXPECT_LE(largest, 65536u + 64);
+    EXPECT_GT(calls, expect.size() / 65600);
+
+    // a FILE* and a file descriptor
+    std::string path = testing::TempDir() + "writer_test.json";
+    FILE* fp = fopen(path.c_str(), "wb");
+    ASSERT_NE(nullptr, fp);
+    {
+        json::writer out(fp);
+        EXPECT_TRUE(out.write(j));
+    }
+    fclose(fp);
+    json back;
+    EXPECT_EQ(json::JSON_PARSE_OK, back.parseFile(path));
+    EXPECT_TRUE(back.isEqual(j));
+    int fd = open(path.c_str(), O_WRONLY | O_TRUNC);
+    ASSERT_GE(fd, 0);
+    {
+        json::writer out(fd);
+        EXPECT_TRUE(out.write(j));
+    }
+    close(fd);
+    back.setNull();
+    EXPECT_EQ(json::JSON_PARSE_OK, back.parseFile(path));
+    EXPECT_TRUE(back.isEqual(j));
+    remove(path.c_str());
+
+    // a fixed buffer, large enough or not
+    std::vector<char> buffer(expect.size());
+    {
+        json::writer out(buffer.data(), buffer.size());
+        EXPECT_TRUE(out.write(j));
+        EXPECT_TRUE(out.flush());
+        EXPECT_EQ(expect.size(), out.size());
+    }
+    EXPECT_EQ(expect, std::string(buffer.data(), buffer.size()));
+    json small;
+    small.parse("[1,2,3]");
+    {
+        json::writer out(buffer.data(), 5);
+        EXPECT_TRUE(out.write(small));
+        EXPECT_FALSE(out.flush());
+        EXPECT_FALSE(out.good());
+        EXPECT_EQ(0u, out.size());
+    }
+    // a sink that fails stops the writer
+    calls = 0;
+    {
+        json::writer out([&](const char*, size_t) { ++ calls; return false; });
+        EXPECT_FALSE(out.write(j));
+        EXPECT_FALSE(out.write(j));
+    }
+    EXPECT_EQ(1u, calls);
+}
+
+TEST(DumpTest, DumpParallel) {
+    using json = xushun::json;
+    json records;
+    records.setArray();
+    for (int i = 0; i < 5000; ++ i) {
+        json record;
+        record["id"] = (double)i;
+        record["k\"ey"] = std::string(i % 31, 'x') + "\"\n" + std::to_string(i);
+        record["v"].setArray();
+        record["v"].pushbackArray(json((double)i / 7));
+        records.pushbackArray(record);
+    }
+    // the records at the root, under a key among others, or below a few small containers
+    std::vector<json> docs(6);
+    docs[0] = records;
+    docs[1].parse("{\"a\":[1,{\"b\":2}],\"data\":null,\"z\":{\"y\":[3]}}");
+    docs[1]["data"] = records;
+    docs[2].parse("[[1],[[2,[]],null],\"s\"]");
+    docs[2][1][0][1] = records;
+    docs[3].parse("[1, [], {}, \"s\", [2]]");
+    docs[4].parse(std::string(900, '[') + std::string(900, ']'));
+    docs[5].parse("{\"one\":[1,2,3,4,5,6,7,8,9]}");
+    for (json& doc : docs) {
+        std::string expect = doc.dump();
+        for (unsigned threads = 0; threads <= 8; ++ threads) {
+            EXPECT_EQ(expect, doc.dumpParallel(threads)) << threads;
+            std::ostringstream os;
+            {
+                json::writer out(os);
+                EXPECT_TRUE(out.write(doc, threads));
+            }
+            EXPECT_EQ(expect, os.str()) << threads;
+        }
+    }
+    const char* leaves[] = {"1", "\"a\\n\"", "[]", "{}", "[true]", "{\"a\":null}"};
+    for (const char* leaf : leaves) {
+        json j;
+        j.parse(leaf);
+        EXPECT_EQ(j.dump(), j.dumpParallel(4));
+    }
+    // a sink that fails stops the rounds
+    size_t calls = 0;
+    {
+        json::writer out([&](const char*, size_t) { ++ calls; return false; });
+        EXPECT_FALSE(out.write(records, 4));
+    }
+    EXPECT_EQ(1u, calls);
+}
+
 
 
 
@@ -62,6 +62,9 @@ TEST(ErrorTest, NumberTooBig) {
     using json = xushun::json;
     TEST_ERROR(json::JSON_PARSE_NUMBER_TOO_BIG, "1e309");
     TEST_ERROR(json::JSON_PARSE_NUMBER_TOO_BIG, "-1e309");
+    TEST_ERROR(json::JSON_PARSE_NUMBER_TOO_BIG, "1.7976931348623159e308");
+    TEST_ERROR(json::JSON_PARSE_NUMBER_TOO_BIG, "123456789012345678901234567890e300");
+    TEST_ERROR(json::JSON_PARSE_NUMBER_TOO_BIG, "1e99999999999999999999");
 }
 
 TEST(ErrorTest, MissingQuotationMark) {
@@ -82,6 +85,7 @@ TEST(ErrorTest, InvalidStringChar) {
     using json = xushun::json;
     TEST_ERROR(json::JSON_PARSE_INVALID_STRING_CHAR, "\"\x01\""); // "(0x01)" 单个char值
     TEST_ERROR(json::JSON_PARSE_INVALID_STRING_CHAR, "\"\x1F\"");
+    TEST_ERROR(json::JSON_PARSE_INVALID_STRING_CHAR, std::string("\"\0\"", 3)); // NUL inside the input
 }
 
 TEST(ErrorTest, InvalidUnicodeHex) {
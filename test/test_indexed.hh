@@ -0,0 +1,106 @@
+/*
+*  @Filename : test_indexed.hh
+*  @Description : unit test for the two-pass indexed parser
+*  @Datatime : 2026/10/21 10:26:37
+*  @Author : xushun
+*/
+#ifndef  __TEST_INDEXED_HH_
+#define  __TEST_INDEXED_HH_
+
+
+#include <gtest/gtest.h>
+#include "../json.hh"
+#include "test_sax.hh"
+
+
+
+
+
+// the same value, error and events as the recursive parser
+#define TEST_INDEXED_SAME(jsonString)\
+    do {\
+        json tree, indexed;\
+        std::string s(jsonString);\
+        EXPECT_EQ(tree.parse(s), indexed.parseIndexed(s)) << s;\
+        EXPECT_EQ(tree.dump(), indexed.dump()) << s;\
+        recordHandler h1, h2;\
+        EXPECT_EQ(json::parse(s.data(), s.size(), h1), json::parseIndexed(s.data(), s.size(), h2)) << s;\
+        EXPECT_EQ(h1.events, h2.events) << s;\
+    } while(0)
+
+TEST(IndexedTest, BlockBoundaries) {
+    using json = xushun::json;
+    // escapes, quotes and runs that straddle the 64 byte blocks at every offset
+    const char* fragments[] = {
+        "\"a\\\\\"", "\"\\\"\"", "\"\\\\\\\"\\\\\"", "\"[{,:}]\"", "123.5e-3", "true", "null", "false",
+        "{\"k\\\"ey\":[1,\"\\\\\"]}", "\"\\u00e9\\n\"", "[ ]", "{ }",
+    };
+    for (const char* fragment : fragments) {
+        for (int pad = 0; pad < 140; ++ pad) {
+            std::string spaces(pad, ' ');
+            TEST_INDEXED_SAME(spaces + "[" + fragment + "," + spaces + fragment + "]" + spaces);
+            TEST_INDEXED_SAME("[\"" + std::string(pad, 'x') + "\"," + fragment + "]");
+        }
+    }
+    // backslash runs of every length across a block end
+    for (int run = 0; run < 130; ++ run) {
+        TEST_INDEXED_SAME("[\"" + std::string(62, 'x') + std::string(run, '\\') + "\",1]");
+    }
+}
+
+TEST(IndexedTest, Truncated) {
+    using json = xushun::json;
+    std::string doc = " {\"a\" : [1, -2.5e3, \"x\\\"y\\\\\"], \"b\" : {\"c\" : null, \"d\" : [true, false, {}]}, \"e\" : \"\\u4e2d\"} ";
+    for (size_t len = 0; len <= doc.size(); ++ len) {
+        TEST_INDEXED_SAME(doc.substr(0, len));
+    }
+    // one byte replaced, anywhere
+    for (size_t i = 0; i < doc.size(); ++ i) {
+        for (char ch : {'x', '"', ',', ':', ']', '}', '\\', '\0', ' '}) {
+            std::string bad = doc;
+            bad[i] = ch;
+            TEST_INDEXED_SAME(bad);
+        }
+    }
+}
+
+TEST(IndexedTest, Large) {
+    using json = xushun::json;
+    std::string engine = json::indexEngine();
+    EXPECT_TRUE(engine == "avx2" || engine == "sse2" || engine == "scalar");
+    // many blocks
+    std::string doc = "[";
+    for (int i = 0; i < 1000; ++ i) {
+        doc += std::string(i > 0 ? "," : "") + "{\"id\":" + std::to_string(i) + ",\"s\":\"v\\\"" + std::to_string(i) + "\"}";
+    }
+    doc += "]";
+    json a, b;
+    EXPECT_EQ(json::JSON_PARSE_OK, a.parse(doc));
+    EXPECT_EQ(json::JSON_PARSE_OK, b.parseIndexed(doc));
+    EXPECT_EQ(a.dump(), b.dump());
+    EXPECT_EQ(1000u, a.getArraySize());
+    EXPECT_EQ("v\"999", a[999]["s"].getString());
+    EXPECT_EQ(json::JSON_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, a.parse(doc.substr(0, doc.size() - 1)));
+    EXPECT_EQ(json::JSON_NULL, a.getType());
+    // an arena document
+    json doc2;
+    doc2.setArena();
+    EXPECT_EQ(json::JSON_PARSE_OK, doc2.parse(doc));
+    EXPECT_TRUE(doc2.isEqual(b));
+}
+
+
+// the parse and error suites once more, with every parse() through parseIndexed()
+#define ParseTest IndexedParseTest
+#define ErrorTest IndexedErrorTest
+#define parse parseIndexed
+#undef  __PARSE_TESTS_HH_
+#undef  __TEST_ERROR_HH_
+#include "test_parse.hh"
+#include "test_error.hh"
+#undef parse
+#undef ErrorTest
+#undef ParseTest
+
+
+#endif // __TEST_INDEXED_HH_
@@ -0,0 +1,93 @@
+/*
+*  @Filename : test_large.hh
+*  @Description : large input test mode, disabled by default
+*  @Datatime : 2026/10/18 13:20:05
+*  @Author : xushun
+*/
+#ifndef  __TEST_LARGE_HH_
+#define  __TEST_LARGE_HH_
+
+
+#include <gtest/gtest.h>
+#include "../json.hh"
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <sys/stat.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdio>
+
+
+// run with:
+// bash test.sh --gtest_also_run_disabled_tests --gtest_filter='LargeTest.*'
+
+// one 64 KB array element, padded with whitespace, with its trailing comma
+static std::string largeTestBlock() {
+    std::string block = "{\"id\":1234567,\"ok\":true,\"v\":[0.5,-1e10,\"abc\\n\"]}";
+    block.resize(64 * 1024 - 1, ' ');
+    block += ',';
+    return block;
+}
+
+// MB/s
+static double largeTestParseRate(const char* data, size_t len, size_t expectSize) {
+    using json = xushun::json;
+    json j;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(json::JSON_PARSE_OK, j.parse(data, len));
+    std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+    EXPECT_EQ(json::JSON_ARRAY, j.getType());
+    EXPECT_EQ(expectSize, j.getArraySize());
+    EXPECT_DOUBLE_EQ(1234567, j[expectSize - 2]["id"].getNumber());
+    EXPECT_EQ("abc\n", j[expectSize - 2]["v"][2].getString());
+    return len / secs.count() / 1e6;
+}
+
+TEST(LargeTest, DISABLED_ParseOver4GB) {
+    using json = xushun::json;
+    const std::string block = largeTestBlock();
+    // small input, parsed from memory
+    const size_t smallBlocks = 1024;
+    std::string small = "[";
+    for (size_t i = 0; i < smallBlocks; ++ i) { small += block; }
+    small += "null]";
+    double smallRate = largeTestParseRate(small.data(), small.size(), smallBlocks + 1);
+    // synthetic file just over 4 GB, parsed in place by parseFile
+    const size_t largeBlocks = (size_t(4) << 30) / block.size() + 1024;
+    std::string path = testing::TempDir() + "large_test.json";
+    FILE* fp = fopen(path.c_str(), "wb");
+    ASSERT_NE(nullptr, fp);
+    fputc('[', fp);
+    for (size_t i = 0; i < largeBlocks; ++ i) {
+        ASSERT_EQ(block.size(), fwrite(block.data(), 1, block.size(), fp));
+    }
+    fputs("null]", fp);
+    fclose(fp);
+    struct stat st;
+    ASSERT_EQ(0, stat(path.c_str(), &st));
+    size_t len = st.st_size;
+    EXPECT_GT(len, size_t(4) << 30);
+    json j;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(json::JSON_PARSE_OK, j.parseFile(path));
+    std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+    unlink(path.c_str());
+    EXPECT_EQ(largeBlocks + 1, j.getArraySize());
+    EXPECT_DOUBLE_EQ(1234567, j[largeBlocks - 1]["id"].getNumber());
+    double largeRate = len / secs.count() / 1e6;
+    printf("small %.1f MB/s, large %.1f MB/s\n", smallRate, largeRate);
+    // the first pass over the file also pays for the page cache
+    EXPECT_GT(largeRate, smallRate * 0.5);
+}
+
+#endif
+
+
+
+
+
+
+
+
+#endif // __TEST_LARGE_HH_
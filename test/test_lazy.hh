@@ -0,0 +1,124 @@
+/*
+*  @Filename : test_lazy.hh
+*  @Description : unit test for on-demand parsing
+*  @Datatime : 2026/10/20 16:22:08
+*  @Author : xushun
+*/
+#ifndef  __TEST_LAZY_HH_
+#define  __TEST_LAZY_HH_
+
+
+#include <gtest/gtest.h>
+#include "../json.hh"
+
+
+
+
+
+// a lazy value reports exactly what the tree parser reports
+#define TEST_LAZY_ERROR(jsonString)\
+    do {\
+        json j, out;\
+        json::lazyValue v;\
+        std::string s(jsonString, sizeof(jsonString) - 1);\
+        EXPECT_EQ(j.parse(s), v.parse(s)) << s;\
+        EXPECT_FALSE(v.exists());\
+        EXPECT_EQ(j.parse(s), v.get(out)) << s;\
+    } while(0)
+
+static const char* lazyTestDoc =
+    " { \"id\" : 7 , \"name\" : \"a\\u0062c\" , \"tags\" : [ \"x\" , [ 1 , \"]\" ] , { \"}\" : \"\\\"\" } ] ,"
+    " \"n\" : null , \"t\" : true , \"f\" : false , \"k\\\\ey\" : -1.5e2 , \"id\" : 8 , \"o\" : { } } ";
+
+TEST(LazyTest, Access) {
+    using json = xushun::json;
+    json::lazyValue doc;
+    EXPECT_EQ(json::JSON_PARSE_OK, doc.parse(lazyTestDoc));
+    EXPECT_EQ(json::JSON_OBJECT, doc.getType());
+    EXPECT_EQ(8u, doc.getObjectSize()); // the second "id" is dropped
+    EXPECT_EQ(7.0, doc["id"].getNumber());
+    EXPECT_EQ("abc", doc["name"].getString());
+    EXPECT_EQ(json::JSON_ARRAY, doc["tags"].getType());
+    EXPECT_EQ(3u, doc["tags"].getArraySize());
+    EXPECT_EQ("x", doc["tags"][0].getString());
+    EXPECT_EQ("]", doc["tags"][1][1].getString());
+    EXPECT_EQ("\"", doc["tags"][2]["}"].getString());
+    EXPECT_EQ(json::JSON_NULL, doc["n"].getType());
+    EXPECT_TRUE(doc["n"].exists());
+    EXPECT_TRUE(doc["t"].getBoolean());
+    EXPECT_FALSE(doc["f"].getBoolean());
+    EXPECT_EQ(-150.0, doc[std::string("k\\ey")].getNumber());
+    EXPECT_EQ(0u, doc["o"].getObjectSize());
+    // a key is the same with or without escapes, and a prefix is another key
+    const char* keysDoc = "{\"a\":1,\"\\u0061\":2,\"ab\":3,\"b\":4,\"a\\u0062\":5,\"\":6,\"b\":7,\"\\\"\":8}";
+    json::lazyValue keys;
+    json keysTree;
+    keys.parse(keysDoc);
+    keysTree.parse(keysDoc);
+    EXPECT_EQ(keysTree.getObjectSize(), keys.getObjectSize());
+    EXPECT_EQ(5u, keys.getObjectSize());
+    // missing values chain without errors
+    EXPECT_FALSE(doc["missing"].exists());
+    EXPECT_FALSE(doc["tags"][3].exists());
+    EXPECT_FALSE(doc["id"]["x"][0].exists());
+    EXPECT_FALSE(doc.existObjectElement("missing"));
+    EXPECT_TRUE(doc.existObjectElement("o"));
+    EXPECT_EQ(json::JSON_NULL, doc["missing"].getType());
+    EXPECT_EQ(json::JSON_PARSE_OK, doc["missing"].error());
+    // the text of a value, and the value built
+    EXPECT_EQ("[ 1 , \"]\" ]", doc["tags"][1].raw().toString());
+    EXPECT_EQ("-1.5e2", doc["k\\ey"].raw().toString());
+    json tags;
+    EXPECT_EQ(json::JSON_PARSE_OK, doc["tags"].get(tags));
+    EXPECT_EQ("[\"x\",[1,\"]\"],{\"}\":\"\\\"\"}]", tags.dump());
+    json all, tree;
+    EXPECT_EQ(json::JSON_PARSE_OK, doc.get(all));
+    EXPECT_EQ(json::JSON_PARSE_OK, tree.parse(lazyTestDoc));
+    EXPECT_TRUE(all.isEqual(tree));
+    EXPECT_EQ(json::JSON_PARSE_EXPECT_VALUE, doc["missing"].get(all));
+    EXPECT_EQ(json::JSON_NULL, all.getType());
+}
+
+TEST(LazyTest, Scalar) {
+    using json = xushun::json;
+    json::lazyValue v;
+    EXPECT_FALSE(v.exists());
+    EXPECT_EQ(json::JSON_PARSE_OK, v.parse(xushun::stringView(" 12 ")));
+    EXPECT_EQ(12.0, v.getNumber());
+    EXPECT_EQ("12", v.raw().toString());
+    EXPECT_EQ(json::JSON_PARSE_OK, v.parse(xushun::stringView("\"\\uD834\\uDD1E\"")));
+    EXPECT_EQ("\xF0\x9D\x84\x9E", v.getString());
+    EXPECT_EQ(0u, v.getArraySize());
+    EXPECT_FALSE(v[0].exists());
+}
+
+TEST(LazyTest, ErrorParity) {
+    using json = xushun::json;
+    TEST_LAZY_ERROR("");
+    TEST_LAZY_ERROR(" ");
+    TEST_LAZY_ERROR("nul");
+    TEST_LAZY_ERROR("?");
+    TEST_LAZY_ERROR("+0");
+    TEST_LAZY_ERROR("1.");
+    TEST_LAZY_ERROR("[1,]");
+    TEST_LAZY_ERROR("[\"a\", nul]");
+    TEST_LAZY_ERROR("null x");
+    TEST_LAZY_ERROR("0123");
+    TEST_LAZY_ERROR("1e309");
+    TEST_LAZY_ERROR("\"abc");
+    TEST_LAZY_ERROR("\"\\v\"");
+    TEST_LAZY_ERROR("\"\x01\"");
+    TEST_LAZY_ERROR("\"a\0b\"");
+    TEST_LAZY_ERROR("\"\\uD800\"");
+    TEST_LAZY_ERROR("\"\\u12G4\"");
+    TEST_LAZY_ERROR("[1");
+    TEST_LAZY_ERROR("[1}");
+    TEST_LAZY_ERROR("[[]");
+    TEST_LAZY_ERROR("{:1,");
+    TEST_LAZY_ERROR("{\"a\"}");
+    TEST_LAZY_ERROR("{\"a\":1]");
+    TEST_LAZY_ERROR("{\"a\":{}");
+}
+
+
+#endif // __TEST_LAZY_HH_
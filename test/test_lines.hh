@@ -0,0 +1,115 @@
+/*
+*  @Filename : test_lines.hh
+*  @Description : unit test for json lines
+*  @Datatime : 2026/10/18 21:24:37
+*  @Author : xushun
+*/
+#ifndef  __TEST_LINES_HH_
+#define  __TEST_LINES_HH_
+
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include "../json.hh"
+
+
+
+
+
+TEST(LinesTest, Reader) {
+    using json = xushun::json;
+    std::string s = "{\"a\":1}\n\n  [1,2]\r\n\"x\"\n \t\r\nnull";
+    json::lineReader reader(s);
+    json j;
+    std::string dumped;
+    while (reader.next(j)) {
+        dumped += std::to_string(reader.line()) + ":" + j.dump() + " ";
+    }
+    EXPECT_EQ(json::JSON_PARSE_OK, reader.error());
+    EXPECT_EQ("1:{\"a\":1} 3:[1,2] 4:\"x\" 6:null ", dumped);
+
+    json::lineReader bad(xushun::stringView("1\n2\n[3,\n4\n"));
+    EXPECT_TRUE(bad.next(j));
+    EXPECT_TRUE(bad.next(j));
+    EXPECT_FALSE(bad.next(j));
+    EXPECT_EQ(json::JSON_PARSE_EXPECT_VALUE, bad.error());
+    EXPECT_EQ(3u, bad.line());
+    EXPECT_FALSE(bad.next(j));
+
+    std::string path = testing::TempDir() + "lines_test.jsonl";
+    FILE* fp = fopen(path.c_str(), "wb");
+    ASSERT_NE(nullptr, fp);
+    fputs("1\n[2]\n", fp);
+    fclose(fp);
+    json::lineReader file;
+    EXPECT_TRUE(file.open(path));
+    EXPECT_TRUE(file.next(j) && file.next(j));
+    EXPECT_EQ("[2]", j.dump());
+    EXPECT_FALSE(file.next(j));
+    remove(path.c_str());
+    EXPECT_FALSE(file.open(path));
+    EXPECT_EQ(json::JSON_PARSE_FILE_ERROR, file.error());
+#if defined(__unix__) || defined(__APPLE__)
+    // records piped in, as from cat
+    int fds[2];
+    ASSERT_EQ(0, pipe(fds));
+    ASSERT_EQ(10, write(fds[1], "1\n[2]\n\n{}\n", 10));
+    close(fds[1]);
+    json::lineReader piped;
+    EXPECT_TRUE(piped.open("/dev/fd/" + std::to_string(fds[0])));
+    close(fds[0]);
+    dumped.clear();
+    while (piped.next(j)) {
+        dumped += j.dump() + " ";
+    }
+    EXPECT_EQ(json::JSON_PARSE_OK, piped.error());
+    EXPECT_EQ("1 [2] {} ", dumped);
+#endif
+}
+
+TEST(LinesTest, Writer) {
+    using json = xushun::json;
+    std::string out;
+    {
+        json::lineWriter writer(out);
+        json j;
+        j["a"] = 1.0;
+        writer.write(j);
+        j = "x";
+        writer.write(j);
+    }
+    EXPECT_EQ("{\"a\":1}\n\"x\"\n", out);
+}
+
+TEST(LinesTest, Parallel) {
+    using json = xushun::json;
+    std::string s;
+    for (int i = 0; i < 1000; ++ i) {
+        s += "{\"id\":" + std::to_string(i) + ",\"tags\":[\"a\",\"b\"]}\n";
+        if (i % 7 == 0) { s += "\n"; }
+    }
+    for (unsigned threads = 1; threads <= 8; ++ threads) {
+        std::vector<json> records;
+        size_t errorLine = 1;
+        EXPECT_EQ(json::JSON_PARSE_OK, json::parseLines(s, records, errorLine, threads));
+        EXPECT_EQ(0u, errorLine);
+        ASSERT_EQ(1000u, records.size());
+        for (int i = 0; i < 1000; ++ i) {
+            EXPECT_EQ(i, records[i]["id"].getNumber());
+        }
+    }
+    // the first error wins, whichever thread finds it
+    std::string bad = s;
+    bad.replace(bad.find("\"id\":500"), 8, "\"id\":5x0");
+    bad.replace(bad.find("\"id\":900"), 8, "\"id\"900");
+    for (unsigned threads = 1; threads <= 8; ++ threads) {
+        std::vector<json> records;
+        size_t errorLine = 0;
+        EXPECT_EQ(json::JSON_PARSE_MISS_COMMA_OR_CURLY_BRACKET, json::parseLines(bad, records, errorLine, threads));
+        EXPECT_EQ(501u + 499 / 7 + 1, errorLine); // blank lines after every 7th record
+        EXPECT_EQ(500u, records.size());
+    }
+}
+
+
+#endif // __TEST_LINES_HH_
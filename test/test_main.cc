@@ -3,6 +3,18 @@
 #include "test_error.hh"
 #include "test_dump.hh"
 #include "test_access.hh"
+#include "test_sax.hh"
+#include "test_stream.hh"
+#include "test_lines.hh"
+#include "test_arena.hh"
+#include "test_lazy.hh"
+#include "test_indexed.hh"
+#include "test_cbor.hh"
+#include "test_depth.hh"
+#include "test_context.hh"
+#include "test_parallel.hh"
+#include "test_pointer.hh"
+#include "test_large.hh"
 
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,97 @@
+/*
+*  @Filename : test_parallel.hh
+*  @Description : unit test for the parallel parse of a top-level array
+*  @Datatime : 2026/10/23 10:36:18
+*  @Author : xushun
+*/
+#ifndef  __TEST_PARALLEL_HH_
+#define  __TEST_PARALLEL_HH_
+
+
+#include <gtest/gtest.h>
+#include "../json.hh"
+
+
+
+
+
+// a large array whose strings hold the chars it is cut at
+std::string parallelDoc(int count) {
+    std::string doc = " [ ";
+    for (int i = 0; i < count; ++ i) {
+        if (i > 0) { doc += i % 3 == 0 ? " ,\n" : ","; }
+        doc += "{\"id\":" + std::to_string(i) + ",\"s\":\"a, [b] {c}\\\", \\\\\",\"v\":[" + std::to_string(i * 0.5)
+             + ",true,null,[]],\"o\":{\"k\":\"]\"}}";
+    }
+    return doc + " ] ";
+}
+
+// parseParallel() gives what parse() gives, for any number of threads
+#define TEST_PARALLEL(jsonString)\
+    do {\
+        std::string s(jsonString);\
+        json expect;\
+        json::jsonError error = expect.parse(s);\
+        for (unsigned threads = 0; threads <= 4; ++ threads) {\
+            json j;\
+            j.setBoolean(true);\
+            EXPECT_EQ(error, j.parseParallel(s.data(), s.size(), threads)) << threads;\
+            EXPECT_TRUE(j.isEqual(expect)) << threads;\
+        }\
+    } while(0)
+
+TEST(ParallelTest, Parse) {
+    using json = xushun::json;
+    std::string doc = parallelDoc(16000);
+    ASSERT_GT(doc.size(), 4u * 256 * 1024);
+    TEST_PARALLEL(doc);
+    json j;
+    EXPECT_EQ(json::JSON_PARSE_OK, j.parseParallel(xushun::stringView(doc), 4));
+    EXPECT_EQ(16000u, j.getArraySize());
+    EXPECT_EQ(15999.0, j[15999]["id"].getNumber());
+    EXPECT_EQ("a, [b] {c}\", \\", j[12345]["s"].getString());
+    // small, or not an array
+    TEST_PARALLEL("[1, 2, 3]");
+    TEST_PARALLEL("{\"a\":" + doc + "}");
+    TEST_PARALLEL("\"" + std::string(600000, ',') + "\"");
+    // an arena document is parsed in one go
+    json a;
+    a.setArena();
+    EXPECT_EQ(json::JSON_PARSE_OK, a.parseParallel(xushun::stringView(doc), 4));
+    EXPECT_TRUE(a.isEqual(j));
+}
+
+TEST(ParallelTest, Error) {
+    using json = xushun::json;
+    std::string doc = parallelDoc(16000);
+    size_t mid = doc.find("{\"id\":12000,");
+    // in an element, between elements, and around the array
+    std::string bad = doc;
+    bad[mid + 1] = 'x';
+    TEST_PARALLEL(bad);
+    bad = doc;
+    bad.insert(mid, "1");
+    TEST_PARALLEL(bad);
+    bad = doc;
+    bad.insert(mid, ",");
+    TEST_PARALLEL(bad);
+    TEST_PARALLEL(doc.substr(0, doc.size() - 2));
+    TEST_PARALLEL(doc + "x");
+    TEST_PARALLEL(doc + "]");
+    bad = doc;
+    bad[bad.size() - 2] = '}';
+    TEST_PARALLEL(bad);
+    TEST_PARALLEL(doc.substr(0, doc.size() - 2) + ",]");
+    bad = doc;
+    bad[mid] = '[';
+    TEST_PARALLEL(bad);
+    // the depth limit counts the top-level array
+    json::setMaxDepth(3);
+    TEST_PARALLEL(doc);
+    json::setMaxDepth(4);
+    TEST_PARALLEL(doc);
+    json::setMaxDepth(1000);
+}
+
+
+#endif // __TEST_PARALLEL_HH_
@@ -9,6 +9,7 @@
 
 
 #include <gtest/gtest.h>
+#include <thread>
 #include "../json.hh"
 
 
@@ -73,6 +74,34 @@ TEST(ParseTest, ParseNumber) {
     PARSE_NUMBER(-1.7976931348623157e+308, "-1.7976931348623157e+308");
 }
 
+// number conversion must be exact, not just close
+#define PARSE_NUMBER_EXACT(expectNum, jsonString)\
+    do {\
+        json j;\
+        EXPECT_EQ(json::JSON_PARSE_OK, j.parse(jsonString));\
+        EXPECT_EQ(json::JSON_NUMBER, j.getType());\
+        EXPECT_EQ(expectNum, j.getNumber());\
+    } while(0)
+
+TEST(ParseTest, ParseNumberExact) {
+    using json = xushun::json;
+    PARSE_NUMBER_EXACT(0.1, "0.1");
+    PARSE_NUMBER_EXACT(0.3, "0.3");
+    PARSE_NUMBER_EXACT(123456.789, "123456.789");
+    PARSE_NUMBER_EXACT(1e23, "1e23");
+    PARSE_NUMBER_EXACT(1e-300, "0.000001e-294");
+    PARSE_NUMBER_EXACT(9007199254740992.0, "9007199254740993"); /* halfway, round to even */
+    PARSE_NUMBER_EXACT(9007199254740996.0, "9007199254740995");
+    PARSE_NUMBER_EXACT(2.2250738585072011e-308, "2.2250738585072011e-308");
+    PARSE_NUMBER_EXACT(4.9406564584124654e-324, "2.4703282292062328e-324"); /* rounds up to min denormal */
+    PARSE_NUMBER_EXACT(0.0, "2.4703282292062327e-324");
+    // more than 19 significant digits
+    PARSE_NUMBER_EXACT(1.2345678901234568e29, "123456789012345678901234567890");
+    PARSE_NUMBER_EXACT(1.2345678901234568e-30, "0.0000000000000000000000000000012345678901234567890123");
+    PARSE_NUMBER_EXACT(9007199254740994.0, "9007199254740993.0000000000000000001");
+    PARSE_NUMBER_EXACT(1e-10, "100000000000000000000000000e-36");
+}
+
 // test string
 #define PARSE_STRING(expectString, jsonString)\
     do {\
@@ -98,6 +127,22 @@ TEST(ParseTest, ParseString) {
     PARSE_STRING("\xF0\x9D\x84\x9E", "\"\\ud834\\udd1e\"");  /* G clef sign U+1D11E */
 }
 
+// long runs of plain chars with an escape, a control char or the end at every offset
+TEST(ParseTest, ParseLongString) {
+    using json = xushun::json;
+    for (size_t len = 0; len < 80; ++ len) {
+        std::string plain;
+        for (size_t i = 0; i < len; ++ i) { plain += (char)('a' + i % 26); }
+        PARSE_STRING(plain, "\"" + plain + "\"");
+        PARSE_STRING(plain + "\n" + plain, "\"" + plain + "\\n" + plain + "\"");
+        PARSE_STRING(plain + "\"\xC2\xA2", "\"" + plain + "\\\"\\u00A2\"");
+        json j;
+        EXPECT_EQ(json::JSON_PARSE_INVALID_STRING_CHAR, j.parse("\"" + plain + "\x1f" + plain + "\""));
+        EXPECT_EQ(json::JSON_PARSE_MISS_QUOTATION_MARK, j.parse("\"" + plain));
+        EXPECT_EQ(json::JSON_PARSE_INVALID_STRING_ESCAPE, j.parse("\"" + plain + "\\x\""));
+    }
+}
+
 
 // test array
 TEST(ParseTest, ParseArray) {
@@ -192,6 +237,67 @@ TEST(ParseTest, ParseObject) {
     j.setNull();
 }
 
+// test parsing straight from a caller's buffer
+TEST(ParseTest, ParseBuffer) {
+    using json = xushun::json;
+    json j;
+    // not NUL-terminated, bytes past len are never read
+    const char buf[] = { '[', '1', ',', '2', ']', 'x' };
+    EXPECT_EQ(json::JSON_PARSE_OK, j.parse(buf, 5));
+    EXPECT_EQ(2, j.getArraySize());
+    EXPECT_EQ(json::JSON_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, j.parse(buf, 2));
+    EXPECT_EQ(json::JSON_PARSE_ROOT_NOT_SINGULAR, j.parse(buf, 6));
+    const char lit[] = { 't', 'r', 'u' };
+    EXPECT_EQ(json::JSON_PARSE_INVALID_VALUE, j.parse(lit, 3));
+    const char str[] = { '\"', 'a', 'b' };
+    EXPECT_EQ(json::JSON_PARSE_MISS_QUOTATION_MARK, j.parse(str, 3));
+    const char hex[] = { '\"', '\\', 'u', '0', '0' };
+    EXPECT_EQ(json::JSON_PARSE_INVALID_UNICODE_HEX, j.parse(hex, 5));
+    // view into a larger string
+    std::string doc("{\"a\":\"hello\"} trailing");
+    EXPECT_EQ(json::JSON_PARSE_OK, j.parse(xushun::stringView(doc.data(), 13)));
+    EXPECT_EQ("hello", j["a"].getString());
+    EXPECT_EQ(json::JSON_PARSE_EXPECT_VALUE, j.parse(xushun::stringView()));
+}
+
+TEST(ParseTest, ParseFile) {
+    using json = xushun::json;
+    json j;
+    std::string path = testing::TempDir() + "parse_file_test.json";
+    FILE* fp = fopen(path.c_str(), "wb");
+    ASSERT_NE(nullptr, fp);
+    fputs(" {\"a\" : [1, 2.5, \"x\\ty\"], \"b\" : null} ", fp);
+    fclose(fp);
+    EXPECT_EQ(json::JSON_PARSE_OK, j.parseFile(path));
+    EXPECT_EQ("{\"a\":[1,2.5,\"x\\ty\"],\"b\":null}", j.dump());
+    fp = fopen(path.c_str(), "wb");
+    fclose(fp);
+    EXPECT_EQ(json::JSON_PARSE_EXPECT_VALUE, j.parseFile(path));
+    remove(path.c_str());
+    j.setBoolean(true);
+    EXPECT_EQ(json::JSON_PARSE_FILE_ERROR, j.parseFile(path));
+    EXPECT_EQ(json::JSON_NULL, j.getType());
+#if defined(__unix__) || defined(__APPLE__)
+    // a pipe has no size, it is read to the end: small, and more than the pipe holds at once
+    for (size_t count : {2, 100000}) {
+        std::string text = "[1";
+        for (size_t i = 1; i < count; ++ i) { text += "," + std::to_string(i); }
+        text += "]";
+        int fds[2];
+        ASSERT_EQ(0, pipe(fds));
+        std::thread writer([&]() {
+            EXPECT_EQ((ssize_t)text.size(), write(fds[1], text.data(), text.size()));
+            close(fds[1]);
+        });
+        EXPECT_EQ(json::JSON_PARSE_OK, j.parseFile("/dev/fd/" + std::to_string(fds[0])));
+        writer.join();
+        close(fds[0]);
+        EXPECT_EQ(count, j.getArraySize());
+        EXPECT_EQ(text, j.dump());
+    }
+#endif
+}
+
 
 
 
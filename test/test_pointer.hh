@@ -0,0 +1,160 @@
+/*
+*  @Filename : test_pointer.hh
+*  @Description : unit test for json pointer lookups in a tree, lazily and by events
+*  @Datatime : 2026/10/23 17:25:09
+*  @Author : xushun
+*/
+#ifndef  __TEST_POINTER_HH_
+#define  __TEST_POINTER_HH_
+
+
+#include <gtest/gtest.h>
+#include "../json.hh"
+#include "test_sax.hh"
+
+
+
+
+
+// the tree, the lazy value and the events find the same value, "" if there is none
+#define TEST_POINTER(expect, doc, pointerText)\
+    do {\
+        json::pointer p(pointerText);\
+        json j;\
+        EXPECT_EQ(json::JSON_PARSE_OK, j.parse(doc));\
+        std::string before = j.dump();\
+        json* found = j.find(p);\
+        EXPECT_EQ(expect, found == nullptr ? "" : found->dump()) << pointerText;\
+        EXPECT_EQ(before, j.dump());\
+        json::lazyValue lazy;\
+        EXPECT_EQ(json::JSON_PARSE_OK, lazy.parse(xushun::stringView(doc)));\
+        json::lazyValue value = lazy.find(p);\
+        json got;\
+        EXPECT_EQ(found != nullptr, value.exists()) << pointerText;\
+        if (value.exists()) {\
+            EXPECT_EQ(json::JSON_PARSE_OK, value.get(got));\
+            EXPECT_EQ(expect, got.dump()) << pointerText;\
+        }\
+        recordHandler h, events;\
+        EXPECT_EQ(json::JSON_PARSE_OK, json::parse(xushun::stringView(doc), p, h));\
+        if (value.exists()) {\
+            json::parse(value.raw(), events);\
+        }\
+        EXPECT_EQ(events.events, h.events) << pointerText;\
+    } while(0)
+
+TEST(PointerTest, Rfc6901) {
+    using json = xushun::json;
+    // the examples of RFC 6901
+    std::string doc = "{\"foo\": [\"bar\", \"baz\"], \"\": 0, \"a/b\": 1, \"c%d\": 2, \"e^f\": 3, \"g|h\": 4,"
+                      " \"i\\\\j\": 5, \"k\\\"l\": 6, \" \": 7, \"m~n\": 8}";
+    json whole;
+    whole.parse(doc);
+    TEST_POINTER(whole.dump(), doc, "");
+    TEST_POINTER("[\"bar\",\"baz\"]", doc, "/foo");
+    TEST_POINTER("\"bar\"", doc, "/foo/0");
+    TEST_POINTER("0", doc, "/");
+    TEST_POINTER("1", doc, "/a~1b");
+    TEST_POINTER("2", doc, "/c%d");
+    TEST_POINTER("3", doc, "/e^f");
+    TEST_POINTER("4", doc, "/g|h");
+    TEST_POINTER("5", doc, "/i\\j");
+    TEST_POINTER("6", doc, "/k\"l");
+    TEST_POINTER("7", doc, "/ ");
+    TEST_POINTER("8", doc, "/m~0n");
+    // nothing there
+    TEST_POINTER("", doc, "/foo/2");
+    TEST_POINTER("", doc, "/foo/-");
+    TEST_POINTER("", doc, "/foo/01");
+    TEST_POINTER("", doc, "/foo/bar");
+    TEST_POINTER("", doc, "/foo/0/x");
+    TEST_POINTER("", doc, "/x");
+    TEST_POINTER("", doc, "/ /x");
+    TEST_POINTER("", doc, "/a~1b/0");
+    TEST_POINTER("", doc, "/foo/99999999999999999999");
+}
+
+TEST(PointerTest, Nested) {
+    using json = xushun::json;
+    std::string doc = "{\"z\": \"before\", \"a\": {\"b\": [1, {\"c\": [true, null, []]}, {}], \"bb\": {}},"
+                      " \"o\": {\"1\": \"one\", \"0\": \"zero\"}, \"k\\u00e9y\": [[], [[\"deep\"]]], \"d\": 1, \"d\": 2}";
+    TEST_POINTER("[1,{\"c\":[true,null,[]]},{}]", doc, "/a/b");
+    TEST_POINTER("{\"c\":[true,null,[]]}", doc, "/a/b/1");
+    TEST_POINTER("null", doc, "/a/b/1/c/1");
+    TEST_POINTER("[]", doc, "/a/b/1/c/2");
+    TEST_POINTER("{}", doc, "/a/b/2");
+    TEST_POINTER("{}", doc, "/a/bb");
+    TEST_POINTER("\"one\"", doc, "/o/1");
+    TEST_POINTER("\"zero\"", doc, "/o/0");
+    TEST_POINTER("\"deep\"", doc, "/k\xc3\xa9y/1/0/0");
+    TEST_POINTER("\"before\"", doc, "/z");
+    TEST_POINTER("", doc, "/a/b/3");
+    TEST_POINTER("", doc, "/a/b/1/c/2/0");
+    TEST_POINTER("", doc, "/z/0");
+    TEST_POINTER("", doc, "/o/2");
+    // the first of two members with a key, as in parse()
+    json j;
+    j.parse(doc);
+    TEST_POINTER(j["d"].dump(), doc, "/d");
+    TEST_POINTER("[1]", "[1]", "");
+    TEST_POINTER("1", "[1]", "/0");
+    TEST_POINTER("", "\"s\"", "/0");
+    TEST_POINTER("", "{}", "/");
+}
+
+TEST(PointerTest, Compile) {
+    using json = xushun::json;
+    json::pointer root, empty(""), slash("/"), path("/a~1b/0/~0");
+    EXPECT_TRUE(root.valid());
+    EXPECT_EQ(0u, root.size());
+    EXPECT_TRUE(empty.valid());
+    EXPECT_EQ(0u, empty.size());
+    EXPECT_TRUE(slash.valid());
+    EXPECT_EQ(1u, slash.size());
+    EXPECT_TRUE(path.valid());
+    EXPECT_EQ(3u, path.size());
+    // not pointers, they find nothing
+    const char* invalid[] = {"a", "#/a", "/a~", "/a~2", "/~~0"};
+    json j;
+    j.parse("{\"a\": 1, \"a~\": 2}");
+    for (const char* text : invalid) {
+        json::pointer p(text);
+        EXPECT_FALSE(p.valid()) << text;
+        EXPECT_EQ(nullptr, j.find(p)) << text;
+        recordHandler h;
+        EXPECT_EQ(json::JSON_PARSE_OK, json::parse(xushun::stringView("{\"a\": 1}"), p, h));
+        EXPECT_EQ("", h.events);
+    }
+    // one pointer for many documents, a lookup inserts nothing
+    json::pointer p("/a/x");
+    EXPECT_EQ(nullptr, j.find(p));
+    EXPECT_EQ(2u, j.getObjectSize());
+    json k;
+    k.parse("{\"a\": {\"x\": [3]}}");
+    ASSERT_NE(nullptr, k.find(p));
+    EXPECT_EQ("[3]", k.find(p)->dump());
+}
+
+TEST(PointerTest, Events) {
+    using json = xushun::json;
+    // the parse stops after the value, what follows is not read
+    recordHandler h;
+    EXPECT_EQ(json::JSON_PARSE_OK, json::parse(xushun::stringView("[1, {\"a\": [2, 3]}, x"), json::pointer("/1/a"), h));
+    EXPECT_EQ("[ 2 3 ]2 ", h.events);
+    h.events.clear();
+    EXPECT_EQ(json::JSON_PARSE_OK, json::parse(xushun::stringView("{\"a\": {\"b\": 1}, \"c\": x"), json::pointer("/a/c"), h));
+    EXPECT_EQ("", h.events);
+    // errors before it, and a handler that stops
+    EXPECT_EQ(json::JSON_PARSE_INVALID_VALUE, json::parse(xushun::stringView("[x, 1]"), json::pointer("/1"), h));
+    recordHandler stop;
+    stop.limit = 2;
+    EXPECT_EQ(json::JSON_PARSE_TERMINATED, json::parse(xushun::stringView("[0, [1, 2, 3]]"), json::pointer("/1"), stop));
+    EXPECT_EQ("[ 1 ", stop.events);
+    stop.events.clear();
+    stop.limit = 1;
+    EXPECT_EQ(json::JSON_PARSE_TERMINATED, json::parse(xushun::stringView("[0, 1]"), json::pointer("/1"), stop));
+    EXPECT_EQ("1 ", stop.events);
+}
+
+
+#endif // __TEST_POINTER_HH_
@@ -0,0 +1,112 @@
+/*
+*  @Filename : test_sax.hh
+*  @Description : unit test for the event parser
+*  @Datatime : 2026/10/18 19:05:12
+*  @Author : xushun
+*/
+#ifndef  __TEST_SAX_HH_
+#define  __TEST_SAX_HH_
+
+
+#include <gtest/gtest.h>
+#include "../json.hh"
+
+
+
+
+
+// writes every event as one token, stops after limit events
+class recordHandler : public xushun::json::handler {
+    public:
+        std::string events;
+        int limit = -1;
+        bool next(const std::string& event) {
+            events += event + " ";
+            return limit < 0 || -- limit > 0;
+        }
+        bool null() override { return next("n"); }
+        bool boolean(bool b) override { return next(b ? "t" : "f"); }
+        bool number(double num) override { char buf[32]; snprintf(buf, sizeof(buf), "%g", num); return next(buf); }
+        bool string(const xushun::stringView& str) override { return next("s:" + str.toString()); }
+        bool startObject() override { return next("{"); }
+        bool key(const xushun::stringView& key) override { return next("k:" + key.toString()); }
+        bool endObject(size_t memberCount) override { return next("}" + std::to_string(memberCount)); }
+        bool startArray() override { return next("["); }
+        bool endArray(size_t elementCount) override { return next("]" + std::to_string(elementCount)); }
+};
+
+#define TEST_SAX(expect, jsonString)\
+    do {\
+        recordHandler h;\
+        EXPECT_EQ(json::JSON_PARSE_OK, json::parse(xushun::stringView(jsonString), h));\
+        EXPECT_EQ(expect, h.events);\
+    } while(0)
+
+// the event parser must reject exactly what the tree parser rejects
+#define TEST_SAX_ERROR(jsonString)\
+    do {\
+        json j;\
+        recordHandler h;\
+        std::string s(jsonString, sizeof(jsonString) - 1);\
+        EXPECT_EQ(j.parse(s), json::parse(xushun::stringView(s), h)) << s;\
+    } while(0)
+
+TEST(SaxTest, Events) {
+    using json = xushun::json;
+    TEST_SAX("n ", "null");
+    TEST_SAX("t ", " true ");
+    TEST_SAX("f ", "false");
+    TEST_SAX("-1.5 ", "-1.5");
+    TEST_SAX("s:abc ", "\"abc\"");
+    TEST_SAX("s:a\"b\n ", "\"a\\\"b\\n\"");
+    TEST_SAX("[ ]0 ", "[ ]");
+    TEST_SAX("{ }0 ", "{ }");
+    TEST_SAX("[ n f t 123 s:abc [ 1 2 ]2 ]6 ", "[ null , false , true , 123 , \"abc\", [1,2] ]");
+    TEST_SAX("{ k:n n k:a\tb [ ]0 k:o { k:1 1 k:2 s:x }2 }3 ",
+        "{ \"n\" : null , \"a\\tb\" : [ ] , \"o\" : { \"1\" : 1, \"2\" : \"x\" } }");
+}
+
+TEST(SaxTest, ErrorParity) {
+    using json = xushun::json;
+    TEST_SAX_ERROR("");
+    TEST_SAX_ERROR(" ");
+    TEST_SAX_ERROR("nul");
+    TEST_SAX_ERROR("?");
+    TEST_SAX_ERROR("+0");
+    TEST_SAX_ERROR("1.");
+    TEST_SAX_ERROR("[1,]");
+    TEST_SAX_ERROR("[\"a\", nul]");
+    TEST_SAX_ERROR("null x");
+    TEST_SAX_ERROR("0123");
+    TEST_SAX_ERROR("1e309");
+    TEST_SAX_ERROR("\"abc");
+    TEST_SAX_ERROR("\"\\v\"");
+    TEST_SAX_ERROR("\"\x01\"");
+    TEST_SAX_ERROR("\"a\0b\"");
+    TEST_SAX_ERROR("\"\\uD800\"");
+    TEST_SAX_ERROR("\"\\u12G4\"");
+    TEST_SAX_ERROR("[1");
+    TEST_SAX_ERROR("[1}");
+    TEST_SAX_ERROR("[[]");
+    TEST_SAX_ERROR("{:1,");
+    TEST_SAX_ERROR("{1:1,");
+    TEST_SAX_ERROR("{\"a\"}");
+    TEST_SAX_ERROR("{\"a\",\"b\"}");
+    TEST_SAX_ERROR("{\"a\":1");
+    TEST_SAX_ERROR("{\"a\":1]");
+    TEST_SAX_ERROR("{\"a\":{}");
+}
+
+TEST(SaxTest, Terminate) {
+    using json = xushun::json;
+    recordHandler h;
+    h.limit = 3;
+    EXPECT_EQ(json::JSON_PARSE_TERMINATED, json::parse(xushun::stringView("[1, {\"a\": 2}, 3]"), h));
+    EXPECT_EQ("[ 1 { ", h.events);
+    recordHandler all;
+    EXPECT_EQ(json::JSON_PARSE_OK, json::parse(xushun::stringView("[1, {\"a\": 2}, 3]"), all));
+    EXPECT_EQ("[ 1 { k:a 2 }1 3 ]3 ", all.events);
+}
+
+
+#endif // __TEST_SAX_HH_
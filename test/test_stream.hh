@@ -0,0 +1,120 @@
+/*
+*  @Filename : test_stream.hh
+*  @Description : unit test for the chunked parser
+*  @Datatime : 2026/10/18 20:38:51
+*  @Author : xushun
+*/
+#ifndef  __TEST_STREAM_HH_
+#define  __TEST_STREAM_HH_
+
+
+#include <gtest/gtest.h>
+#include "../json.hh"
+
+
+
+
+
+// feeds s cut into pieces of step bytes, the first piece is cut at first
+xushun::json::jsonError streamParse(xushun::json& j, const std::string& s, size_t first, size_t step) {
+    using json = xushun::json;
+    json::streamParser parser(j);
+    json::jsonError ret = parser.feed(s.data(), first);
+    for (size_t i = first; i < s.size() && ret == json::JSON_PARSE_OK; i += step) {
+        ret = parser.feed(s.data() + i, std::min(step, s.size() - i));
+    }
+    return ret == json::JSON_PARSE_OK ? parser.finish() : ret;
+}
+
+// every way of cutting the input must give what the tree parser gives
+#define TEST_STREAM(jsonString)\
+    do {\
+        std::string s(jsonString, sizeof(jsonString) - 1);\
+        json expect;\
+        json::jsonError error = expect.parse(s);\
+        for (size_t first = 0; first <= s.size(); ++ first) {\
+            for (size_t step = 1; step <= 3; ++ step) {\
+                json j;\
+                j.setBoolean(true);\
+                EXPECT_EQ(error, streamParse(j, s, first, step)) << s << " cut at " << first;\
+                EXPECT_EQ(expect.dump(), j.dump()) << s << " cut at " << first;\
+            }\
+        }\
+    } while(0)
+
+TEST(StreamTest, Value) {
+    using json = xushun::json;
+    TEST_STREAM("null");
+    TEST_STREAM(" true ");
+    TEST_STREAM("false");
+    TEST_STREAM("-1.25e+10");
+    TEST_STREAM("1.7976931348623157e308");
+    TEST_STREAM("\"\"");
+    TEST_STREAM("\"Hello\\nWorld\\\\\"");
+    TEST_STREAM("\"\\u20AC \\uD834\\uDD1E \\\"\"");
+    TEST_STREAM("[ null , false , true , 123 , \"abc\", [1,[2]] ]");
+    TEST_STREAM("{ \"n\" : null , \"a\\tb\" : [ ] , \"o\" : { \"1\" : 1, \"2\" : \"x\" } , \"n\" : [1] }");
+}
+
+TEST(StreamTest, Error) {
+    using json = xushun::json;
+    TEST_STREAM("");
+    TEST_STREAM(" ");
+    TEST_STREAM("nul");
+    TEST_STREAM("nulll");
+    TEST_STREAM("?");
+    TEST_STREAM("+0");
+    TEST_STREAM("1.");
+    TEST_STREAM("0123");
+    TEST_STREAM("1e309");
+    TEST_STREAM("null x");
+    TEST_STREAM("[1,]");
+    TEST_STREAM("[\"a\", nul]");
+    TEST_STREAM("\"abc");
+    TEST_STREAM("\"\\");
+    TEST_STREAM("\"\\v\"");
+    TEST_STREAM("\"\x01\"");
+    TEST_STREAM("\"a\0b\"");
+    TEST_STREAM("\"\\uD800\"");
+    TEST_STREAM("\"\\u12G4\"");
+    TEST_STREAM("[");
+    TEST_STREAM("[1");
+    TEST_STREAM("[1,");
+    TEST_STREAM("[1}");
+    TEST_STREAM("[[]");
+    TEST_STREAM("[1\"a\"]");
+    TEST_STREAM("{");
+    TEST_STREAM("{:1,");
+    TEST_STREAM("{1:1,");
+    TEST_STREAM("{\"a\"");
+    TEST_STREAM("{\"a\"}");
+    TEST_STREAM("{\"a\":");
+    TEST_STREAM("{\"a\":1");
+    TEST_STREAM("{\"a\":1,");
+    TEST_STREAM("{\"a\":1]");
+    TEST_STREAM("{\"a\":{}");
+}
+
+TEST(StreamTest, Events) {
+    using json = xushun::json;
+    recordHandler h;
+    json::streamParser parser(h);
+    EXPECT_EQ(json::JSON_PARSE_OK, parser.feed("[tr"));
+    EXPECT_EQ("[ ", h.events);
+    EXPECT_EQ(json::JSON_PARSE_OK, parser.feed("ue, \"\\u00"));
+    EXPECT_EQ("[ t ", h.events);
+    EXPECT_EQ(json::JSON_PARSE_OK, parser.feed("41\", 1"));
+    EXPECT_EQ(json::JSON_PARSE_OK, parser.feed("2]"));
+    EXPECT_EQ(json::JSON_PARSE_OK, parser.finish());
+    EXPECT_EQ("[ t s:A 12 ]3 ", h.events);
+    // the parser is reusable after reset
+    parser.reset();
+    h.events.clear();
+    EXPECT_EQ(json::JSON_PARSE_OK, parser.feed("{}"));
+    EXPECT_EQ(json::JSON_PARSE_ROOT_NOT_SINGULAR, parser.feed(" {}"));
+    EXPECT_EQ(json::JSON_PARSE_ROOT_NOT_SINGULAR, parser.finish());
+    EXPECT_EQ("{ }0 ", h.events);
+}
+
+
+#endif // __TEST_STREAM_HH_